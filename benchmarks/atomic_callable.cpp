@@ -0,0 +1,85 @@
+#include "framework/benchmark.hpp"
+
+#include <atomic_callable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t callers = 32;
+
+// the `shared_mutex` protected callable the atomic callable replaces
+struct locked_handler
+{
+  template<typename... SourceTs>
+  void store(SourceTs&&... sources)
+  {
+    tmf::callable<std::uint64_t(std::uint64_t)> replacement{ std::forward<SourceTs>(sources)... };
+    std::unique_lock<std::shared_mutex> lock{ mutex };
+    target = std::move(replacement);
+  }
+
+  std::uint64_t operator()(std::uint64_t value) const
+  {
+    std::shared_lock<std::shared_mutex> lock{ mutex };
+    return target(value);
+  }
+
+  mutable std::shared_mutex mutex;
+  tmf::callable<std::uint64_t(std::uint64_t)> target;
+};
+
+struct alignas(64) counter
+{
+  std::uint64_t value = 0;
+};
+
+// `callers` threads call the handler as fast as they can while one more thread keeps replacing it, as config
+// reloads would
+template<typename HandlerT>
+void
+calls_during_swaps(bench::state& state)
+{
+  HandlerT handler;
+  handler.store([](std::uint64_t value) { return value + 1; });
+  std::vector<counter> calls(callers);
+  std::uint64_t swaps = 0;
+  auto seconds =
+    bench::run_concurrently(callers + 1, state.settings().min_seconds * 2, [&](std::size_t index, auto& running) {
+      if (index == callers) {
+        for (std::uint64_t generation = 0; running.load(std::memory_order_relaxed); ++generation) {
+          handler.store([generation](std::uint64_t value) { return value + generation; });
+          ++swaps;
+        }
+        return;
+      }
+      auto& own = calls[index].value;
+      while (running.load(std::memory_order_relaxed)) {
+        bench::do_not_optimize(handler(own));
+        ++own;
+      }
+    });
+  std::uint64_t total = 0;
+  for (auto& count : calls) {
+    total += count.value;
+  }
+  state.record(std::to_string(callers) + " callers", static_cast<double>(total) / seconds / 1e6, "Mcall/s");
+  state.record("swaps", static_cast<double>(swaps) / seconds / 1e3, "kswap/s");
+}
+
+}
+
+BENCHMARK_CASE("atomic callable/calls during swaps/tmf::atomic_callable")
+{
+  calls_during_swaps<tmf::atomic_callable<std::uint64_t(std::uint64_t)>>(state);
+}
+
+BENCHMARK_CASE("atomic callable/calls during swaps/shared_mutex callable")
+{
+  calls_during_swaps<locked_handler>(state);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+// a representative set of signatures and targets, compiled into an object whose symbols the `callable_code_size`
+// target measures. every function has external linkage so its instantiations are kept without being called
+
+#include <callable.hpp>
+
+#include <memory>
+#include <string>
+
+namespace code_size {
+struct ticker
+{
+  void operator()() const { ++ticks; }
+
+  static inline int ticks = 0;
+};
+
+struct increment
+{
+  int operator()(int value) const { return value + step; }
+
+  int step = 1;
+};
+
+struct logger
+{
+  void operator()(const std::string& line) const { written += line.size(); }
+
+  static inline std::size_t written = 0;
+};
+
+struct blend
+{
+  double operator()(double from, double to) const { return from + (to - from) * weight; }
+
+  double weight = 0.5;
+};
+
+template<typename SignatureT, typename FunctorT>
+struct instantiations
+{
+  using callable_type = tmf::callable<SignatureT>;
+
+  static callable_type by_value() { return callable_type{ FunctorT{} }; }
+
+  static callable_type by_pointer(FunctorT* target) { return callable_type{ target }; }
+
+  static callable_type shared(std::shared_ptr<FunctorT>& target) { return callable_type{ target }; }
+
+  static callable_type method(FunctorT* target) { return callable_type{ target, &FunctorT::operator() }; }
+
+  static callable_type function(SignatureT* target) { return callable_type{ target }; }
+};
+
+template struct instantiations<void(), ticker>;
+template struct instantiations<int(int), increment>;
+template struct instantiations<void(const std::string&), logger>;
+template struct instantiations<double(double, double), blend>;
+}
\ No newline at end of file
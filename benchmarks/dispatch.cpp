@@ -0,0 +1,338 @@
+#include "framework/benchmark.hpp"
+
+#include <callable.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+constexpr std::size_t batch = 256;
+
+int
+add_one(int value)
+{
+  return value + 1;
+}
+
+struct adder
+{
+  int operator()(int value) const { return value + offset; }
+
+  int offset = 1;
+};
+
+struct stepper
+{
+  int step(int value) { return value + size; }
+
+  int size = 1;
+};
+
+// the objects referenced, pointed to and shared by the sources
+struct targets
+{
+  adder functor;
+  stepper object;
+  std::shared_ptr<adder> shared_functor = std::make_shared<adder>();
+  std::shared_ptr<stepper> shared_object = std::make_shared<stepper>();
+};
+
+// the usual alternative to type erasure by hand: an interface, its implementations on the heap
+struct interface
+{
+  virtual ~interface() = default;
+  virtual int operator()(int value) = 0;
+  virtual std::unique_ptr<interface> clone() const = 0;
+};
+
+template<typename FunctionT>
+struct implementation final : interface
+{
+  explicit implementation(FunctionT held)
+    : function(held)
+  {}
+
+  int operator()(int value) override { return function(value); }
+
+  std::unique_ptr<interface> clone() const override { return std::make_unique<implementation>(function); }
+
+  FunctionT function;
+};
+
+// a copyable owner of an `interface`, as code passing them by value has to write
+struct virtual_handle
+{
+  template<typename FunctionT>
+  static virtual_handle of(FunctionT function)
+  {
+    return virtual_handle{ std::make_unique<implementation<FunctionT>>(function) };
+  }
+
+  explicit virtual_handle(std::unique_ptr<interface> held)
+    : target(std::move(held))
+  {}
+
+  virtual_handle(const virtual_handle& other)
+    : target(other.target->clone())
+  {}
+
+  virtual_handle(virtual_handle&&) noexcept = default;
+
+  int operator()(int value) const { return (*target)(value); }
+
+  std::unique_ptr<interface> target;
+};
+
+// every source a callable can be initialized with, as listed in the README. `make` builds a callable of type
+// `CallableT` from the source, `function` the closest `std::function`, `handle` the closest virtual interface
+struct from_function_pointer
+{
+  static constexpr const char* name = "function pointer";
+  template<typename CallableT>
+  static CallableT make(targets&) { return CallableT{ &add_one }; }
+  static std::function<int(int)> function(targets&) { return &add_one; }
+  static int (*pointer(targets&))(int) { return &add_one; }
+  static virtual_handle handle(targets&) { return virtual_handle::of(&add_one); }
+};
+
+struct from_functor_value
+{
+  static constexpr const char* name = "functor value";
+  template<typename CallableT>
+  static CallableT make(targets&) { return CallableT{ adder{} }; }
+  static std::function<int(int)> function(targets&) { return adder{}; }
+  static virtual_handle handle(targets&) { return virtual_handle::of(adder{}); }
+};
+
+struct from_functor_reference
+{
+  static constexpr const char* name = "functor reference";
+  template<typename CallableT>
+  static CallableT make(targets& shared) { return CallableT{ shared.functor }; }
+  static std::function<int(int)> function(targets& shared) { return std::ref(shared.functor); }
+};
+
+struct from_functor_pointer
+{
+  static constexpr const char* name = "functor pointer";
+  template<typename CallableT>
+  static CallableT make(targets& shared) { return CallableT{ &shared.functor }; }
+  static std::function<int(int)> function(targets& shared)
+  {
+    return [functor = &shared.functor](int value) { return (*functor)(value); };
+  }
+};
+
+struct from_functor_shared_ptr
+{
+  static constexpr const char* name = "functor shared_ptr";
+  template<typename CallableT>
+  static CallableT make(targets& shared) { return CallableT{ shared.shared_functor }; }
+  static std::function<int(int)> function(targets& shared)
+  {
+    return [functor = shared.shared_functor](int value) { return (*functor)(value); };
+  }
+};
+
+struct from_lambda
+{
+  static constexpr const char* name = "lambda value";
+  template<typename CallableT>
+  static CallableT make(targets&) { return CallableT{ [offset = 1](int value) { return value + offset; } }; }
+  static std::function<int(int)> function(targets&) { return [offset = 1](int value) { return value + offset; }; }
+};
+
+struct from_object_pointer
+{
+  static constexpr const char* name = "object pointer, member";
+  template<typename CallableT>
+  static CallableT make(targets& shared) { return CallableT{ &shared.object, &stepper::step }; }
+  static std::function<int(int)> function(targets& shared) { return std::bind_front(&stepper::step, &shared.object); }
+  static virtual_handle handle(targets& shared)
+  {
+    return virtual_handle::of([object = &shared.object](int value) { return object->step(value); });
+  }
+};
+
+struct from_object_value
+{
+  static constexpr const char* name = "object value, member";
+  template<typename CallableT>
+  static CallableT make(targets&) { return CallableT{ stepper{}, &stepper::step }; }
+  static std::function<int(int)> function(targets&) { return std::bind_front(&stepper::step, stepper{}); }
+};
+
+struct from_object_shared_ptr
+{
+  static constexpr const char* name = "object shared_ptr, member";
+  template<typename CallableT>
+  static CallableT make(targets& shared) { return CallableT{ shared.shared_object, &stepper::step }; }
+  static std::function<int(int)> function(targets& shared)
+  {
+    return std::bind_front(&stepper::step, shared.shared_object);
+  }
+};
+
+// the implementations compared, each building its type from a source
+template<std::size_t Capacity>
+struct with_callable
+{
+  using type = tmf::callable<int(int), Capacity>;
+  static std::string name() { return "tmf::callable<" + std::to_string(Capacity) + ">"; }
+  template<typename SourceT>
+  static type make(targets& shared) { return SourceT::template make<type>(shared); }
+};
+
+struct with_function
+{
+  using type = std::function<int(int)>;
+  static std::string name() { return "std::function"; }
+  template<typename SourceT>
+  static type make(targets& shared) { return SourceT::function(shared); }
+};
+
+struct with_pointer
+{
+  using type = int (*)(int);
+  static std::string name() { return "function pointer"; }
+  template<typename SourceT>
+  static type make(targets& shared) { return SourceT::pointer(shared); }
+};
+
+struct with_virtual
+{
+  using type = virtual_handle;
+  static std::string name() { return "virtual interface"; }
+  template<typename SourceT>
+  static type make(targets& shared) { return SourceT::handle(shared); }
+};
+
+// `batch` objects of type `T` in raw storage, constructed and destroyed all at once
+template<typename T>
+struct slots
+{
+  using storage_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+  slots()
+    : storage(new storage_type[batch])
+  {}
+
+  ~slots() { clear(); }
+
+  T& operator[](std::size_t index) { return *std::launder(reinterpret_cast<T*>(&storage[index])); }
+
+  // construct every object from `build(index)`
+  template<typename BuildT>
+  void fill(BuildT build)
+  {
+    for (std::size_t index = 0; index < batch; ++index) {
+      new (&storage[index]) T(build(index));
+    }
+    live = true;
+  }
+
+  void clear()
+  {
+    if (live) {
+      for (std::size_t index = 0; index < batch; ++index) {
+        (*this)[index].~T();
+      }
+      live = false;
+    }
+  }
+
+  std::unique_ptr<storage_type[]> storage;
+  bool live = false;
+};
+
+// construction, copy, move, destruction and invocation of `T` built by `make`, per object
+template<typename T, typename MakeT>
+void
+lifecycle(bench::state& state, MakeT make)
+{
+  slots<T> sources;
+  slots<T> copies;
+  auto made = [&make](std::size_t) { return make(); };
+  state.measure("construct", [&] { copies.clear(); }, [&] { copies.fill(made); }, batch);
+  sources.fill(made);
+  state.measure(
+    "copy",
+    [&] { copies.clear(); },
+    [&] { copies.fill([&sources](std::size_t index) -> const T& { return sources[index]; }); },
+    batch);
+  state.measure(
+    "move",
+    [&] {
+      copies.clear();
+      sources.clear();
+      sources.fill(made);
+    },
+    [&] { copies.fill([&sources](std::size_t index) -> T&& { return std::move(sources[index]); }); },
+    batch);
+  state.measure(
+    "destroy",
+    [&] {
+      copies.clear();
+      copies.fill(made);
+    },
+    [&] { copies.clear(); },
+    batch);
+  copies.clear();
+  copies.fill(made);
+  int value = 0;
+  state.measure(
+    "invoke",
+    [&] {
+      for (std::size_t index = 0; index < batch; ++index) {
+        value = copies[index](value & 1023);
+      }
+      bench::do_not_optimize(value);
+    },
+    batch);
+}
+
+template<typename SourceT, typename ImplementationT>
+void
+dispatch_case(bench::state& state)
+{
+  targets shared;
+  lifecycle<typename ImplementationT::type>(state,
+                                            [&shared] { return ImplementationT::template make<SourceT>(shared); });
+}
+
+// registers "dispatch/<source>/<implementation>" for every implementation
+template<typename SourceT, typename... ImplementationTs>
+bool
+register_source()
+{
+  // the registry keeps the names by pointer
+  static std::deque<std::string> names;
+  (names.push_back(std::string{ "dispatch/" } + SourceT::name + "/" + ImplementationTs::name()), ...);
+  auto name = names.begin();
+  (bench::registrar{ (name++)->c_str(), &dispatch_case<SourceT, ImplementationTs> }, ...);
+  return true;
+}
+
+template<typename SourceT>
+bool
+register_callables()
+{
+  return register_source<SourceT, with_callable<32>, with_callable<64>, with_callable<128>, with_function>();
+}
+
+const bool registered = register_source<from_function_pointer, with_pointer, with_virtual>() &&
+                        register_callables<from_function_pointer>() && register_callables<from_functor_value>() &&
+                        register_source<from_functor_value, with_virtual>() &&
+                        register_callables<from_functor_reference>() && register_callables<from_functor_pointer>() &&
+                        register_callables<from_functor_shared_ptr>() && register_callables<from_lambda>() &&
+                        register_callables<from_object_pointer>() &&
+                        register_source<from_object_pointer, with_virtual>() &&
+                        register_callables<from_object_value>() && register_callables<from_object_shared_ptr>();
+
+}
\ No newline at end of file
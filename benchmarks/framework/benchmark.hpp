@@ -0,0 +1,270 @@
+#pragma once
+
+#include "counters.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define BENCHMARK_CONCATENATE_IMPL(a, b) a##b
+#define BENCHMARK_CONCATENATE(a, b) BENCHMARK_CONCATENATE_IMPL(a, b)
+
+// defines a benchmark case, the body receives `bench::state& state`
+#define BENCHMARK_CASE(name)                                                                                           \
+  static void BENCHMARK_CONCATENATE(benchmark_case_, __LINE__)(bench::state&);                                         \
+  static const bench::registrar BENCHMARK_CONCATENATE(benchmark_registrar_, __LINE__){                                 \
+    name, &BENCHMARK_CONCATENATE(benchmark_case_, __LINE__)                                                            \
+  };                                                                                                                   \
+  static void BENCHMARK_CONCATENATE(benchmark_case_, __LINE__)(bench::state & state)
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+// keeps the optimizer from discarding `value` or the work that produced it
+template<typename T>
+inline void
+do_not_optimize(T const& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// keeps the optimizer from assuming memory is unchanged across this point
+inline void
+clobber_memory()
+{
+  asm volatile("" : : : "memory");
+}
+
+// one measured quantity of a benchmark case, e.g. nanoseconds per call
+struct metric
+{
+  std::string name;
+  double value;
+  std::string unit;
+  // every sample `value` is the median of, empty for quantities recorded by the case itself
+  std::vector<double> samples = {};
+};
+
+struct settings
+{
+  // a measurement keeps doubling its iteration count until a run lasts at least this long
+  double min_seconds = 0.05;
+  // completed runs per measurement, the median is reported
+  std::size_t samples = 5;
+  // also report the hardware counters of the measured runs per item, where they can be opened
+  bool counters = true;
+};
+
+class state
+{
+public:
+  state(std::string name, const settings& options)
+    : m_name(std::move(name))
+    , m_settings(options)
+  {}
+
+  // times repeated calls of `body`, recording the median nanoseconds per item; `items` is how many items a
+  // single call of `body` processes
+  template<typename BodyT>
+  void measure(const std::string& metric_name, BodyT&& body, std::size_t items = 1)
+  {
+    std::size_t iterations = 1;
+    for (;;) {
+      if (run(body, iterations) >= m_settings.min_seconds || iterations >= (std::size_t{ 1 } << 40)) {
+        break;
+      }
+      iterations *= 2;
+    }
+    auto hardware = hardware_counters();
+    std::vector<double> nanoseconds;
+    for (std::size_t sample = 0; sample < m_settings.samples; ++sample) {
+      if (hardware != nullptr) {
+        hardware->start();
+      }
+      nanoseconds.push_back(run(body, iterations) * 1e9 / static_cast<double>(iterations * items));
+      if (hardware != nullptr) {
+        hardware->stop();
+      }
+    }
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    record(metric_name, nanoseconds[nanoseconds.size() / 2], "ns");
+    m_metrics.back().samples = std::move(nanoseconds);
+    if (hardware != nullptr) {
+      // the loop around `body` is counted along with it
+      record_counters(metric_name, *hardware, hardware->read(), iterations * items, "per item, with loop");
+    }
+  }
+
+  // as above, but runs `setup` before every call of `body` without timing it, for operations that need fresh
+  // state each time, such as destroying what the previous call constructed
+  template<typename SetupT, typename BodyT>
+  void measure(const std::string& metric_name, SetupT&& setup, BodyT&& body, std::size_t items)
+  {
+    std::size_t iterations = 1;
+    for (;;) {
+      if (run(setup, body, iterations) >= m_settings.min_seconds || iterations >= (std::size_t{ 1 } << 40)) {
+        break;
+      }
+      iterations *= 2;
+    }
+    auto hardware = hardware_counters();
+    std::vector<double> nanoseconds;
+    for (std::size_t sample = 0; sample < m_settings.samples; ++sample) {
+      if (hardware != nullptr) {
+        hardware->start();
+      }
+      nanoseconds.push_back(run(setup, body, iterations) * 1e9 / static_cast<double>(iterations * items));
+      if (hardware != nullptr) {
+        hardware->stop();
+      }
+    }
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    record(metric_name, nanoseconds[nanoseconds.size() / 2], "ns");
+    m_metrics.back().samples = std::move(nanoseconds);
+    if (hardware != nullptr) {
+      // counters run across whole samples, setup and timing included. the same samples with an empty body count
+      // only those, and are taken away
+      auto counted = hardware->read();
+      hardware->reset();
+      auto nothing = [] {};
+      for (std::size_t sample = 0; sample < m_settings.samples; ++sample) {
+        hardware->start();
+        run(setup, nothing, iterations);
+        hardware->stop();
+      }
+      auto overhead = hardware->read();
+      for (std::size_t index = 0; index < counters::events; ++index) {
+        counted[index] = counted[index] > overhead[index] ? counted[index] - overhead[index] : 0;
+      }
+      record_counters(metric_name, *hardware, counted, iterations * items, "per item, net of setup");
+    }
+  }
+
+  // records a quantity measured by the case itself
+  void record(std::string metric_name, double value, std::string unit)
+  {
+    m_metrics.push_back({ std::move(metric_name), value, std::move(unit) });
+  }
+
+  const std::string& name() const { return m_name; }
+
+  const std::vector<metric>& metrics() const { return m_metrics; }
+
+  const bench::settings& settings() const { return m_settings; }
+
+private:
+  template<typename BodyT>
+  static double run(BodyT& body, std::size_t iterations)
+  {
+    auto start = clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+      body();
+    }
+    clobber_memory();
+    return std::chrono::duration<double>(clock::now() - start).count();
+  }
+
+  template<typename SetupT, typename BodyT>
+  static double run(SetupT& setup, BodyT& body, std::size_t iterations)
+  {
+    clock::duration elapsed{};
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+      setup();
+      clobber_memory();
+      auto start = clock::now();
+      body();
+      clobber_memory();
+      elapsed += clock::now() - start;
+    }
+    return std::chrono::duration<double>(elapsed).count();
+  }
+
+  // the zeroed counters of the calling thread, or null when they are switched off or cannot be opened
+  counters* hardware_counters()
+  {
+    if (!m_settings.counters || !counters::local().available()) {
+      return nullptr;
+    }
+    counters::local().reset();
+    return &counters::local();
+  }
+
+  // every opened event of `counted` divided by the items processed in all samples, `unit` says what the count
+  // includes besides the measured body
+  void record_counters(const std::string& metric_name,
+                       const counters& hardware,
+                       const counters::values& counted,
+                       std::size_t items,
+                       const char* unit)
+  {
+    for (std::size_t index = 0; index < counters::events; ++index) {
+      if (hardware.opened(index)) {
+        record(metric_name + " " + counters::names[index],
+               static_cast<double>(counted[index]) / static_cast<double>(items * m_settings.samples),
+               unit);
+      }
+    }
+  }
+
+  std::string m_name;
+  bench::settings m_settings;
+  std::vector<metric> m_metrics;
+};
+
+// runs `body(thread_index, running)` on `threads` threads at once for about `seconds`, bodies keep working while
+// `running` holds true. returns the seconds elapsed until every thread finished
+template<typename BodyT>
+inline double
+run_concurrently(std::size_t threads, double seconds, BodyT body)
+{
+  std::atomic<bool> running{ true };
+  std::atomic<std::size_t> started{ 0 };
+  std::vector<std::thread> workers;
+  for (std::size_t index = 0; index < threads; ++index) {
+    workers.emplace_back([&, index] {
+      started.fetch_add(1);
+      while (started.load() < threads) {
+        std::this_thread::yield();
+      }
+      body(index, running);
+    });
+  }
+  while (started.load() < threads) {
+    std::this_thread::yield();
+  }
+  auto start = clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  running.store(false);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+using case_function = void (*)(state&);
+
+struct registered_case
+{
+  const char* name;
+  case_function function;
+};
+
+inline std::vector<registered_case>&
+registry()
+{
+  static std::vector<registered_case> cases;
+  return cases;
+}
+
+struct registrar
+{
+  registrar(const char* name, case_function function) { registry().push_back({ name, function }); }
+};
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,385 @@
+// compares two JSON files written by `callable_benchmarks --json`, metric by metric
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// just enough JSON for what the benchmarks write
+struct value
+{
+  enum class kind
+  {
+    null,
+    boolean,
+    number,
+    string,
+    array,
+    object
+  };
+
+  kind type = kind::null;
+  bool boolean = false;
+  double number = 0.0;
+  std::string text;
+  std::vector<value> items;
+  std::vector<std::string> keys;
+
+  // the member named `key` of an object, or null when there is none
+  const value* find(const std::string& key) const
+  {
+    for (std::size_t index = 0; index < keys.size(); ++index) {
+      if (keys[index] == key) {
+        return &items[index];
+      }
+    }
+    return nullptr;
+  }
+};
+
+class parser
+{
+public:
+  explicit parser(const std::string& document)
+    : m_document(document)
+  {}
+
+  value parse()
+  {
+    auto parsed = parse_value();
+    skip_space();
+    if (m_position != m_document.size()) {
+      fail("trailing characters");
+    }
+    return parsed;
+  }
+
+private:
+  [[noreturn]] void fail(const char* reason) const
+  {
+    throw std::runtime_error{ std::string{ reason } + " at offset " + std::to_string(m_position) };
+  }
+
+  void skip_space()
+  {
+    while (m_position < m_document.size() && std::strchr(" \t\r\n", m_document[m_position]) != nullptr) {
+      ++m_position;
+    }
+  }
+
+  bool consume(char expected)
+  {
+    skip_space();
+    if (m_position < m_document.size() && m_document[m_position] == expected) {
+      ++m_position;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char expected)
+  {
+    if (!consume(expected)) {
+      fail((std::string{ "expected '" } + expected + "'").c_str());
+    }
+  }
+
+  bool consume_word(const char* word)
+  {
+    auto length = std::strlen(word);
+    if (m_document.compare(m_position, length, word) == 0) {
+      m_position += length;
+      return true;
+    }
+    return false;
+  }
+
+  std::string parse_string()
+  {
+    expect('"');
+    std::string text;
+    while (m_position < m_document.size() && m_document[m_position] != '"') {
+      if (m_document[m_position] == '\\' && m_position + 1 < m_document.size()) {
+        ++m_position;
+      }
+      text += m_document[m_position++];
+    }
+    expect('"');
+    return text;
+  }
+
+  value parse_value()
+  {
+    value parsed;
+    skip_space();
+    if (m_position == m_document.size()) {
+      fail("unexpected end");
+    }
+    char first = m_document[m_position];
+    if (first == '{') {
+      parsed.type = value::kind::object;
+      ++m_position;
+      if (!consume('}')) {
+        do {
+          parsed.keys.push_back(parse_string());
+          expect(':');
+          parsed.items.push_back(parse_value());
+        } while (consume(','));
+        expect('}');
+      }
+    } else if (first == '[') {
+      parsed.type = value::kind::array;
+      ++m_position;
+      if (!consume(']')) {
+        do {
+          parsed.items.push_back(parse_value());
+        } while (consume(','));
+        expect(']');
+      }
+    } else if (first == '"') {
+      parsed.type = value::kind::string;
+      parsed.text = parse_string();
+    } else if (consume_word("true") || consume_word("false")) {
+      parsed.type = value::kind::boolean;
+      parsed.boolean = first == 't';
+    } else if (consume_word("null")) {
+      parsed.type = value::kind::null;
+    } else {
+      char* end = nullptr;
+      parsed.type = value::kind::number;
+      parsed.number = std::strtod(m_document.c_str() + m_position, &end);
+      if (end == m_document.c_str() + m_position) {
+        fail("expected a value");
+      }
+      m_position = static_cast<std::size_t>(end - m_document.c_str());
+    }
+    return parsed;
+  }
+
+  const std::string& m_document;
+  std::size_t m_position = 0;
+};
+
+struct measurement
+{
+  double value;
+  std::string unit;
+  std::vector<double> samples;
+};
+
+// every metric of a file, by case and metric name
+using results = std::map<std::pair<std::string, std::string>, measurement>;
+
+results
+load(const char* path)
+{
+  std::ifstream file{ path, std::ios::binary };
+  if (!file) {
+    throw std::runtime_error{ std::string{ "could not read " } + path };
+  }
+  std::string document{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+  auto root = parser{ document }.parse();
+  auto listed = root.find("results");
+  if (listed == nullptr || listed->type != value::kind::array) {
+    throw std::runtime_error{ std::string{ path } + " has no results" };
+  }
+  results loaded;
+  for (auto& result : listed->items) {
+    auto name = result.find("case");
+    auto metric = result.find("metric");
+    auto measured = result.find("value");
+    auto unit = result.find("unit");
+    if (name == nullptr || metric == nullptr || measured == nullptr || unit == nullptr) {
+      throw std::runtime_error{ std::string{ path } + " has an incomplete result" };
+    }
+    measurement entry{ measured->number, unit->text, {} };
+    if (auto samples = result.find("samples")) {
+      for (auto& sample : samples->items) {
+        entry.samples.push_back(sample.number);
+      }
+    }
+    loaded[{ name->text, metric->text }] = std::move(entry);
+  }
+  return loaded;
+}
+
+// the two-sided 95% quantile of Student's t distribution with `degrees` degrees of freedom
+double
+t_quantile(double degrees)
+{
+  static constexpr double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                      2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+  if (degrees < 1.0) {
+    degrees = 1.0;
+  }
+  if (degrees <= 30.0) {
+    return table[static_cast<std::size_t>(degrees) - 1];
+  }
+  // Cornish-Fisher expansion around the normal quantile
+  constexpr double z = 1.959964;
+  return z + (z * z * z + z) / (4.0 * degrees) + (5.0 * std::pow(z, 5) + 16.0 * z * z * z + 3.0 * z) /
+                                                   (96.0 * degrees * degrees);
+}
+
+struct statistics
+{
+  double mean = 0.0;
+  double variance = 0.0;
+};
+
+statistics
+describe(const std::vector<double>& samples)
+{
+  statistics described;
+  for (auto sample : samples) {
+    described.mean += sample;
+  }
+  described.mean /= static_cast<double>(samples.size());
+  for (auto sample : samples) {
+    described.variance += (sample - described.mean) * (sample - described.mean);
+  }
+  described.variance /= static_cast<double>(samples.size() - 1);
+  return described;
+}
+
+// the half width of the 95% confidence interval of the difference of the means, by Welch's t-test
+double
+interval(const std::vector<double>& baseline, const std::vector<double>& candidate)
+{
+  auto before = describe(baseline);
+  auto after = describe(candidate);
+  auto before_error = before.variance / static_cast<double>(baseline.size());
+  auto after_error = after.variance / static_cast<double>(candidate.size());
+  auto error = before_error + after_error;
+  if (error == 0.0) {
+    return 0.0;
+  }
+  auto degrees = error * error / (before_error * before_error / static_cast<double>(baseline.size() - 1) +
+                                  after_error * after_error / static_cast<double>(candidate.size() - 1));
+  return t_quantile(degrees) * std::sqrt(error);
+}
+
+// rates get worse as they fall, everything else (times, sizes, counters) as it rises
+bool
+higher_is_better(const std::string& unit)
+{
+  return unit.size() >= 2 && unit.compare(unit.size() - 2, 2, "/s") == 0;
+}
+}
+
+// usage: callable_benchmark_compare [--threshold percent] baseline.json candidate.json
+// prints the change of every metric found in both files. when both carry samples, the change of the means comes
+// with a 95% confidence interval, and only a change whose interval lies entirely beyond the threshold is flagged.
+// metrics without samples (sizes, rates recorded by a case) are flagged when they change by more than the
+// threshold. a metric that was zero in the baseline has no relative change, any other value is flagged. exits with
+// 1 when anything regressed
+int
+main(int argc, char** argv)
+{
+  double threshold = 5.0;
+  std::vector<const char*> paths;
+  for (int index = 1; index < argc; ++index) {
+    if (std::strcmp(argv[index], "--threshold") == 0 && index + 1 < argc) {
+      threshold = std::atof(argv[++index]);
+    } else {
+      paths.push_back(argv[index]);
+    }
+  }
+  if (paths.size() != 2) {
+    std::fprintf(stderr, "usage: %s [--threshold percent] baseline.json candidate.json\n", argv[0]);
+    return 2;
+  }
+  results baseline;
+  results candidate;
+  try {
+    baseline = load(paths[0]);
+    candidate = load(paths[1]);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 2;
+  }
+
+  std::size_t regressions = 0;
+  std::size_t improvements = 0;
+  for (auto& [key, before] : baseline) {
+    auto found = candidate.find(key);
+    if (found == candidate.end()) {
+      std::printf("%-60s %-24s only in baseline\n", key.first.c_str(), key.second.c_str());
+      continue;
+    }
+    auto& after = found->second;
+    if (before.value == 0.0) {
+      const char* verdict = "";
+      if (after.value != 0.0) {
+        if ((after.value > 0.0) == higher_is_better(before.unit)) {
+          verdict = "improvement";
+          ++improvements;
+        } else {
+          verdict = "REGRESSION";
+          ++regressions;
+        }
+      }
+      std::printf("%-60s %-24s %14.3f -> %14.3f %-8s %8s %-20s %s\n",
+                  key.first.c_str(),
+                  key.second.c_str(),
+                  before.value,
+                  after.value,
+                  before.unit.c_str(),
+                  "from 0",
+                  "",
+                  verdict);
+      continue;
+    }
+    auto change = (after.value - before.value) / std::abs(before.value) * 100.0;
+    // the interval is relative to the baseline mean, and the change it qualifies is that of the means
+    bool sampled = before.samples.size() >= 2 && after.samples.size() >= 2;
+    double low = change;
+    double high = change;
+    char bounds[64] = "";
+    if (sampled) {
+      auto before_mean = describe(before.samples).mean;
+      auto mean_change = (describe(after.samples).mean - before_mean) / std::abs(before_mean) * 100.0;
+      auto width = interval(before.samples, after.samples) / std::abs(before_mean) * 100.0;
+      low = mean_change - width;
+      high = mean_change + width;
+      std::snprintf(bounds, sizeof(bounds), "[%+.1f%%, %+.1f%%]", low, high);
+    }
+    auto worse = higher_is_better(before.unit) ? -high : low;
+    auto better = higher_is_better(before.unit) ? low : -high;
+    const char* verdict = "";
+    if (worse > threshold) {
+      verdict = "REGRESSION";
+      ++regressions;
+    } else if (better > threshold) {
+      verdict = "improvement";
+      ++improvements;
+    }
+    std::printf("%-60s %-24s %14.3f -> %14.3f %-8s %+7.1f%% %-20s %s\n",
+                key.first.c_str(),
+                key.second.c_str(),
+                before.value,
+                after.value,
+                before.unit.c_str(),
+                change,
+                bounds,
+                verdict);
+  }
+  for (auto& [key, after] : candidate) {
+    if (baseline.find(key) == baseline.end()) {
+      std::printf("%-60s %-24s only in candidate\n", key.first.c_str(), key.second.c_str());
+    }
+  }
+  std::printf("%zu regressions, %zu improvements beyond %g%%\n", regressions, improvements, threshold);
+  return regressions == 0 ? 0 : 1;
+}
\ No newline at end of file
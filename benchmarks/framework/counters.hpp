@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCHMARK_PERF_EVENTS
+#endif
+
+namespace bench {
+
+// hardware performance counters of the calling thread, read through `perf_event_open`. the events that can be
+// opened are counted as one group so they cover exactly the same instructions, the rest are left out. virtual
+// machines and containers often expose none at all, in which case `available` is false and `reason` says why
+class counters
+{
+public:
+  static constexpr std::size_t events = 4;
+
+  using values = std::array<std::uint64_t, events>;
+
+  // the name each event is reported under
+  static constexpr std::array<const char*, events> names{ "instructions",
+                                                          "branch-misses",
+                                                          "L1-icache-misses",
+                                                          "iTLB-misses" };
+
+  counters()
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    constexpr std::uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const std::array<std::array<std::uint64_t, 2>, events> configurations{ {
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+      { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1I | read_miss },
+      { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_ITLB | read_miss },
+    } };
+    for (std::size_t index = 0; index < events; ++index) {
+      perf_event_attr attributes{};
+      attributes.size = sizeof(attributes);
+      attributes.type = static_cast<std::uint32_t>(configurations[index][0]);
+      attributes.config = configurations[index][1];
+      attributes.disabled = m_leader == -1 ? 1 : 0;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_GROUP;
+      auto descriptor = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, m_leader, 0));
+      if (descriptor == -1) {
+        if (m_reason.empty()) {
+          m_reason = std::string{ names[index] } + ": " + std::strerror(errno);
+        }
+        continue;
+      }
+      if (m_leader == -1) {
+        m_leader = descriptor;
+      }
+      m_descriptors[index] = descriptor;
+      m_slots[index] = m_opened++;
+    }
+#else
+    m_reason = "perf_event_open is not available on this platform";
+#endif
+  }
+
+  counters(const counters&) = delete;
+
+  counters& operator=(const counters&) = delete;
+
+  ~counters()
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    for (auto descriptor : m_descriptors) {
+      if (descriptor != -1) {
+        ::close(descriptor);
+      }
+    }
+#endif
+  }
+
+  // true when at least one event could be opened
+  bool available() const { return m_leader != -1; }
+
+  // true when event `index` could be opened
+  bool opened(std::size_t index) const { return m_descriptors[index] != -1; }
+
+  // why the first event that could not be opened failed, empty when every one was opened
+  const std::string& reason() const { return m_reason; }
+
+  // zero every event
+  void reset()
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    control(PERF_EVENT_IOC_RESET);
+#endif
+  }
+
+  // count from now on
+  void start()
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    control(PERF_EVENT_IOC_ENABLE);
+#endif
+  }
+
+  // stop counting, what was counted so far is kept
+  void stop()
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    control(PERF_EVENT_IOC_DISABLE);
+#endif
+  }
+
+  // the counts since the last `reset`, zero for events that could not be opened
+  values read() const
+  {
+    values counted{};
+#if defined(BENCHMARK_PERF_EVENTS)
+    if (!available()) {
+      return counted;
+    }
+    std::uint64_t group[events + 1]{};
+    if (::read(m_leader, group, sizeof(group)) <= 0) {
+      return counted;
+    }
+    for (std::size_t index = 0; index < events; ++index) {
+      if (opened(index) && m_slots[index] < group[0]) {
+        counted[index] = group[1 + m_slots[index]];
+      }
+    }
+#endif
+    return counted;
+  }
+
+  // counters of the calling thread, opened on its first use
+  static counters& local()
+  {
+    thread_local counters opened;
+    return opened;
+  }
+
+private:
+  void control([[maybe_unused]] unsigned long request)
+  {
+#if defined(BENCHMARK_PERF_EVENTS)
+    if (available()) {
+      ::ioctl(m_leader, request, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  int m_leader = -1;
+  std::size_t m_opened = 0;
+  std::array<int, events> m_descriptors{ -1, -1, -1, -1 };
+  std::array<std::size_t, events> m_slots{};
+  std::string m_reason;
+};
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+// the cheapest timestamp the platform offers, for timing single short operations. the time stamp counter where
+// there is one, the steady clock elsewhere
+struct tick_clock
+{
+  // a timestamp, in no particular order with the instructions around it
+  static std::uint64_t now()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+
+  // a timestamp taken after every earlier instruction completed, and before any later one starts. it opens a
+  // timed region, so that work (such as a load) inside it cannot begin ahead of it
+  static std::uint64_t start()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    auto ticks = __rdtsc();
+    _mm_lfence();
+    return ticks;
+#else
+    return now();
+#endif
+  }
+
+  // a timestamp taken after every earlier instruction completed, and before any later one starts, closing a
+  // timed region
+  static std::uint64_t stop()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned processor;
+    auto ticks = __rdtscp(&processor);
+    _mm_lfence();
+    return ticks;
+#else
+    return now();
+#endif
+  }
+
+  // nanoseconds per tick, measured against the steady clock on first use
+  static double nanoseconds()
+  {
+    static const double calibrated = [] {
+      auto start = std::chrono::steady_clock::now();
+      auto first = now();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      auto ticks = now() - first;
+      auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      return ticks == 0 ? 1.0 : elapsed / static_cast<double>(ticks);
+    }();
+    return calibrated;
+  }
+};
+
+// counts values in log-linear buckets, in the manner of an HDR histogram: every power of two is split into
+// `sub_buckets / 2` buckets of equal width, so any value is reported within 1/64 of itself. recording is a few
+// instructions and never allocates
+class latency_histogram
+{
+public:
+  static constexpr std::size_t sub_bucket_bits = 7;
+  static constexpr std::size_t sub_buckets = std::size_t{ 1 } << sub_bucket_bits;
+  static constexpr std::size_t half = sub_buckets / 2;
+
+  latency_histogram()
+    : m_counts(sub_buckets + (64 - sub_bucket_bits) * half)
+  {}
+
+  void record(std::uint64_t value)
+  {
+    ++m_counts[index(value)];
+    ++m_total;
+    if (value > m_max) {
+      m_max = value;
+    }
+  }
+
+  void merge(const latency_histogram& other)
+  {
+    for (std::size_t bucket = 0; bucket < m_counts.size(); ++bucket) {
+      m_counts[bucket] += other.m_counts[bucket];
+    }
+    m_total += other.m_total;
+    if (other.m_max > m_max) {
+      m_max = other.m_max;
+    }
+  }
+
+  // the largest value that falls into the same bucket as the value below which `fraction` of the values lie
+  std::uint64_t percentile(double fraction) const
+  {
+    if (m_total == 0) {
+      return 0;
+    }
+    auto needed = static_cast<std::uint64_t>(fraction * static_cast<double>(m_total));
+    if (needed == 0) {
+      needed = 1;
+    }
+    std::uint64_t covered = 0;
+    for (std::size_t bucket = 0; bucket < m_counts.size(); ++bucket) {
+      covered += m_counts[bucket];
+      if (covered >= needed) {
+        auto highest = highest_in(bucket);
+        return highest < m_max ? highest : m_max;
+      }
+    }
+    return m_max;
+  }
+
+  std::uint64_t max() const { return m_max; }
+
+  std::uint64_t count() const { return m_total; }
+
+private:
+  static std::size_t index(std::uint64_t value)
+  {
+    if (value < sub_buckets) {
+      return static_cast<std::size_t>(value);
+    }
+    auto magnitude = static_cast<std::size_t>(63 - __builtin_clzll(value));
+    auto shift = magnitude - (sub_bucket_bits - 1);
+    return sub_buckets + (magnitude - sub_bucket_bits) * half + static_cast<std::size_t>((value >> shift) - half);
+  }
+
+  static std::uint64_t highest_in(std::size_t bucket)
+  {
+    if (bucket < sub_buckets) {
+      return bucket;
+    }
+    auto magnitude = (bucket - sub_buckets) / half + sub_bucket_bits;
+    auto shift = magnitude - (sub_bucket_bits - 1);
+    auto sub = (bucket - sub_buckets) % half + half;
+    return ((static_cast<std::uint64_t>(sub) + 1) << shift) - 1;
+  }
+
+  std::vector<std::uint64_t> m_counts;
+  std::uint64_t m_total = 0;
+  std::uint64_t m_max = 0;
+};
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct result
+{
+  const char* name;
+  bench::metric measured;
+};
+
+std::string
+json_string(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (char character : text) {
+    if (character == '"' || character == '\\') {
+      quoted += '\\';
+    }
+    quoted += character;
+  }
+  return quoted + "\"";
+}
+
+bool
+write_json(const char* path, const bench::settings& options, const std::vector<result>& results)
+{
+  auto file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+  std::fprintf(file,
+               "{\n  \"min_seconds\": %g,\n  \"samples\": %zu,\n  \"results\": [",
+               options.min_seconds,
+               options.samples);
+  for (std::size_t index = 0; index < results.size(); ++index) {
+    auto& measured = results[index].measured;
+    std::fprintf(file,
+                 "%s\n    { \"case\": %s, \"metric\": %s, \"value\": %.17g, \"unit\": %s",
+                 index == 0 ? "" : ",",
+                 json_string(results[index].name).c_str(),
+                 json_string(measured.name).c_str(),
+                 measured.value,
+                 json_string(measured.unit).c_str());
+    if (!measured.samples.empty()) {
+      std::fprintf(file, ", \"samples\": [");
+      for (std::size_t sample = 0; sample < measured.samples.size(); ++sample) {
+        std::fprintf(file, "%s%.17g", sample == 0 ? "" : ", ", measured.samples[sample]);
+      }
+      std::fprintf(file, "]");
+    }
+    std::fprintf(file, " }");
+  }
+  std::fprintf(file, "\n  ]\n}\n");
+  return std::fclose(file) == 0;
+}
+}
+
+// usage: callable_benchmarks [--min-time seconds] [--samples count] [--json path] [--no-counters] [filter]
+// runs every case whose name contains `filter`, and with `--json` also writes every metric to `path`. hardware
+// counters are reported next to each timing unless `--no-counters` is given or they cannot be opened
+int
+main(int argc, char** argv)
+{
+  bench::settings options;
+  std::string filter;
+  const char* json_path = nullptr;
+  std::vector<result> results;
+  for (int index = 1; index < argc; ++index) {
+    if (std::strcmp(argv[index], "--min-time") == 0 && index + 1 < argc) {
+      options.min_seconds = std::atof(argv[++index]);
+    } else if (std::strcmp(argv[index], "--samples") == 0 && index + 1 < argc) {
+      options.samples = static_cast<std::size_t>(std::max(1, std::atoi(argv[++index])));
+    } else if (std::strcmp(argv[index], "--json") == 0 && index + 1 < argc) {
+      json_path = argv[++index];
+    } else if (std::strcmp(argv[index], "--no-counters") == 0) {
+      options.counters = false;
+    } else {
+      filter = argv[index];
+    }
+  }
+  if (options.counters && !bench::counters::local().available()) {
+    std::fprintf(stderr,
+                 "hardware counters unavailable (%s), reporting timings only\n",
+                 bench::counters::local().reason().c_str());
+  } else if (options.counters && !bench::counters::local().reason().empty()) {
+    std::fprintf(stderr, "some hardware counters unavailable (%s)\n", bench::counters::local().reason().c_str());
+  }
+  for (auto& registered : bench::registry()) {
+    if (std::string{ registered.name }.find(filter) == std::string::npos) {
+      continue;
+    }
+    bench::state state{ registered.name, options };
+    registered.function(state);
+    for (auto& measured : state.metrics()) {
+      std::printf("%-60s %-24s %14.3f %s\n", registered.name, measured.name.c_str(), measured.value, measured.unit.c_str());
+      results.push_back({ registered.name, measured });
+    }
+    std::fflush(stdout);
+  }
+  if (json_path != nullptr && !write_json(json_path, options, results)) {
+    std::fprintf(stderr, "could not write %s\n", json_path);
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "framework/benchmark.hpp"
+
+#include <fused.hpp>
+
+#include <cstdint>
+
+namespace {
+
+struct record
+{
+  std::uint64_t key;
+  std::uint64_t value;
+};
+
+std::uint64_t
+parse(std::uint64_t raw)
+{
+  return raw * 2654435761u;
+}
+
+record
+validate(std::uint64_t key)
+{
+  return record{ key, key >> 7 };
+}
+
+}
+
+// every stage its own callable, each one calling the next through its capacity
+BENCHMARK_CASE("fused/three stage pipeline/nested callables")
+{
+  std::uint64_t stored = 0;
+  tmf::callable<void(record)> store{ [&stored](record item) { stored += item.key ^ item.value; } };
+  tmf::callable<void(std::uint64_t)> checked{ [&store](std::uint64_t key) { store(validate(key)); } };
+  tmf::callable<void(std::uint64_t)> handler{ [&checked](std::uint64_t raw) { checked(parse(raw)); } };
+  std::uint64_t raw = 0;
+  state.measure("per call", [&] { handler(++raw); });
+  bench::do_not_optimize(stored);
+}
+
+BENCHMARK_CASE("fused/three stage pipeline/tmf::chain")
+{
+  std::uint64_t stored = 0;
+  auto handler = tmf::chain<std::uint64_t>(tmf::stage<parse>)
+                   .then(tmf::stage<validate>)
+                   .then([&stored](record item) { stored += item.key ^ item.value; })
+                   .to_callable();
+  std::uint64_t raw = 0;
+  state.measure("per call", [&] { handler(++raw); });
+  bench::do_not_optimize(stored);
+}
\ No newline at end of file
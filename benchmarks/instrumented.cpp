@@ -0,0 +1,53 @@
+#include "framework/benchmark.hpp"
+
+#include <callable.hpp>
+
+#include <cstddef>
+
+// built into a program of its own with `TMF_CALLABLE_TRACE` defined, compare with the invoke times of the dispatch
+// cases for the cost of the hook
+#if defined(TMF_CALLABLE_TRACE)
+namespace {
+
+constexpr std::size_t batch = 256;
+
+struct adder
+{
+  int operator()(int value) const { return value + offset; }
+
+  int offset = 1;
+};
+
+void
+invoke(bench::state& state, bool tracing)
+{
+  tmf::callable<int(int)> subject{ adder{} };
+  int value = 0;
+  tmf::callable_trace::enable(tracing);
+  state.measure(
+    "invoke",
+    // draining keeps the buffer from filling up and turning every event into a cheap drop
+    [] { tmf::callable_trace::json(); },
+    [&] {
+      for (std::size_t call = 0; call < batch; ++call) {
+        value = subject(value & 1023);
+      }
+      bench::do_not_optimize(value);
+    },
+    batch);
+  tmf::callable_trace::enable(false);
+  tmf::callable_trace::json();
+}
+
+}
+
+BENCHMARK_CASE("instrumented/functor value/tracing disabled")
+{
+  invoke(state, false);
+}
+
+BENCHMARK_CASE("instrumented/functor value/tracing enabled")
+{
+  invoke(state, true);
+}
+#endif
\ No newline at end of file
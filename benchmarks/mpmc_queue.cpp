@@ -0,0 +1,102 @@
+#include "framework/benchmark.hpp"
+
+#include <mpmc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t queue_length = 1024;
+
+// the mutex protected deque of `std::function` the queue replaces
+struct locked_queue
+{
+  using task_type = std::function<void()>;
+
+  template<typename SourceT>
+  bool try_emplace(SourceT&& source)
+  {
+    std::lock_guard<std::mutex> lock{ mutex };
+    if (tasks.size() == queue_length) {
+      return false;
+    }
+    tasks.emplace_back(std::forward<SourceT>(source));
+    return true;
+  }
+
+  bool try_pop(task_type& task)
+  {
+    std::lock_guard<std::mutex> lock{ mutex };
+    if (tasks.empty()) {
+      return false;
+    }
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    return true;
+  }
+
+  std::mutex mutex;
+  std::deque<task_type> tasks;
+};
+
+struct alignas(64) counter
+{
+  std::uint64_t value = 0;
+};
+
+// half the threads produce tasks as fast as the queue takes them, the other half run them; a single thread
+// alternates between both
+template<typename QueueT>
+void
+throughput(bench::state& state)
+{
+  for (std::size_t threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+    QueueT subject;
+    std::vector<counter> executed(threads);
+    std::uint64_t payload[2]{ 2, 1 };
+    auto seconds =
+      bench::run_concurrently(threads, state.settings().min_seconds * 2, [&](std::size_t index, auto& running) {
+        typename QueueT::task_type task;
+        auto& own = executed[index].value;
+        // tasks capture a few words of state, as bound arguments would
+        auto make_task = [&own, payload] { own += payload[0] - payload[1]; };
+        bool produces = threads == 1 || index % 2 == 0;
+        bool consumes = threads == 1 || index % 2 == 1;
+        while (running.load(std::memory_order_relaxed)) {
+          if (produces && !subject.try_emplace(decltype(make_task){ make_task }) && !consumes) {
+            std::this_thread::yield();
+          }
+          if (consumes) {
+            if (subject.try_pop(task)) {
+              task();
+            } else if (!produces) {
+              std::this_thread::yield();
+            }
+          }
+        }
+      });
+    std::uint64_t total = 0;
+    for (auto& count : executed) {
+      total += count.value;
+    }
+    state.record(std::to_string(threads) + " threads", static_cast<double>(total) / seconds / 1e6, "Mtask/s");
+  }
+}
+
+}
+
+BENCHMARK_CASE("mpmc queue/throughput/tmf::mpmc_queue")
+{
+  throughput<tmf::mpmc_queue<queue_length>>(state);
+}
+
+BENCHMARK_CASE("mpmc queue/throughput/mutex std::function deque")
+{
+  throughput<locked_queue>(state);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "framework/benchmark.hpp"
+
+#include <packaged_task.hpp>
+#include <thread_pool.hpp>
+
+#include <future>
+
+namespace {
+
+// what a request handler returns through its future
+struct reply
+{
+  int status;
+  long length;
+};
+
+auto handle = [](int request) { return reply{ 200, request * 2L }; };
+
+}
+
+BENCHMARK_CASE("packaged task/round trip/tmf::packaged_task")
+{
+  tmf::future_arena<reply, 16> arena;
+  state.measure("same thread", [&] {
+    tmf::packaged_task<reply(int)> task{ handle };
+    auto result = task.get_future(arena);
+    task(21);
+    bench::do_not_optimize(result.get());
+  });
+  tmf::thread_pool<64> pool{ 1 };
+  state.measure("to a worker and back", [&] {
+    tmf::packaged_task<reply(int)> task{ handle };
+    auto result = task.get_future(arena);
+    pool.post([&task] { task(21); });
+    bench::do_not_optimize(result.get());
+  });
+}
+
+BENCHMARK_CASE("packaged task/round trip/std::packaged_task")
+{
+  state.measure("same thread", [&] {
+    std::packaged_task<reply(int)> task{ handle };
+    auto result = task.get_future();
+    task(21);
+    bench::do_not_optimize(result.get());
+  });
+  tmf::thread_pool<64> pool{ 1 };
+  state.measure("to a worker and back", [&] {
+    std::packaged_task<reply(int)> task{ handle };
+    auto result = task.get_future();
+    pool.post([&task] { task(21); });
+    bench::do_not_optimize(result.get());
+  });
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "framework/benchmark.hpp"
+
+#include <per_cpu_queue.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// the single queue every thread shares, behind the interface of `per_cpu_queue`
+struct shared_queue
+{
+  template<typename SourceT>
+  bool try_post(SourceT&& source)
+  {
+    return queue.try_emplace(std::forward<SourceT>(source));
+  }
+
+  size_t run_local()
+  {
+    tmf::mpmc_queue<1024>::task_type task;
+    size_t ran = 0;
+    for (; queue.try_pop(task); ++ran) {
+      task();
+    }
+    return ran;
+  }
+
+  tmf::mpmc_queue<1024> queue;
+};
+
+struct alignas(64) counter
+{
+  std::uint64_t value = 0;
+};
+
+// every thread posts a batch of small tasks and runs whatever its local queue holds, as the workers of an executor
+// posting follow up work would
+template<typename QueueT>
+void
+post_and_run(bench::state& state)
+{
+  for (std::size_t threads : { 1, 4, 16, 64 }) {
+    QueueT subject;
+    std::vector<counter> executed(threads);
+    auto seconds =
+      bench::run_concurrently(threads, state.settings().min_seconds * 2, [&](std::size_t index, auto& running) {
+        auto& own = executed[index].value;
+        while (running.load(std::memory_order_relaxed)) {
+          for (int post = 0; post < 16; ++post) {
+            if (!subject.try_post([&own] { ++own; })) {
+              std::this_thread::yield();
+            }
+          }
+          subject.run_local();
+        }
+      });
+    std::uint64_t total = 0;
+    for (auto& count : executed) {
+      total += count.value;
+    }
+    state.record(std::to_string(threads) + " threads", static_cast<double>(total) / seconds / 1e6, "Mtask/s");
+  }
+}
+
+}
+
+BENCHMARK_CASE("per cpu queue/post and run/tmf::per_cpu_queue")
+{
+  post_and_run<tmf::per_cpu_queue<1024>>(state);
+}
+
+BENCHMARK_CASE("per cpu queue/post and run/shared tmf::mpmc_queue")
+{
+  post_and_run<shared_queue>(state);
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "framework/benchmark.hpp"
+
+#include <proactor.hpp>
+
+#if defined(__linux__)
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <thread_pool.hpp>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t block = 4096;
+constexpr std::size_t blocks = 8192;
+constexpr std::size_t in_flight = 64;
+
+using clock = std::chrono::steady_clock;
+
+clock::time_point
+deadline(const bench::state& state)
+{
+  return clock::now() + std::chrono::duration_cast<clock::duration>(
+                          std::chrono::duration<double>(state.settings().min_seconds * 4));
+}
+
+// a 32 MiB file on tmpfs, unlinked once opened, so reads measure the submission path rather than a disk
+struct tmpfs_file
+{
+  tmpfs_file()
+  {
+    char name[] = "/dev/shm/tmf_proactor_XXXXXX";
+    fd = ::mkstemp(name);
+    ::unlink(name);
+    std::vector<char> contents(block, 'x');
+    for (std::size_t index = 0; index < blocks; ++index) {
+      (void)!::pwrite(fd, contents.data(), block, index * block);
+    }
+  }
+
+  ~tmpfs_file() { ::close(fd); }
+
+  int fd;
+};
+
+std::uint64_t
+next_offset(std::uint64_t& random)
+{
+  random = random * 6364136223846793005u + 1442695040888963407u;
+  return ((random >> 33) % blocks) * block;
+}
+
+// `in_flight` random block reads at a time, each completion queueing the next
+struct reads
+{
+  void next(int result)
+  {
+    completed += result == static_cast<int>(block) ? 1 : 0;
+    if (clock::now() < until) {
+      subject->read(file->fd, buffer, block, next_offset(random), this, &reads::next);
+    }
+  }
+
+  tmf::proactor<>* subject = nullptr;
+  const tmpfs_file* file = nullptr;
+  clock::time_point until;
+  std::uint64_t random = 0;
+  std::uint64_t completed = 0;
+  alignas(64) char buffer[block];
+};
+
+void
+random_reads(bench::state& state, bool emulate)
+{
+  tmpfs_file file;
+  tmf::proactor<> subject{ in_flight, emulate };
+  std::vector<reads> readers(in_flight);
+  auto start = clock::now();
+  auto until = deadline(state);
+  for (std::size_t index = 0; index < in_flight; ++index) {
+    readers[index].subject = &subject;
+    readers[index].file = &file;
+    readers[index].until = until;
+    readers[index].random = index + 1;
+    readers[index].next(0);
+  }
+  while (subject.in_flight() != 0) {
+    subject.run_once();
+  }
+  auto seconds = std::chrono::duration<double>(clock::now() - start).count();
+  std::uint64_t completed = 0;
+  for (auto& reader : readers) {
+    completed += reader.completed;
+  }
+  state.record("4 KiB reads", static_cast<double>(completed) / seconds / 1e3, "kread/s");
+}
+
+}
+
+BENCHMARK_CASE("proactor/random tmpfs reads/tmf::proactor io_uring")
+{
+  random_reads(state, false);
+}
+
+BENCHMARK_CASE("proactor/random tmpfs reads/tmf::proactor emulated")
+{
+  random_reads(state, true);
+}
+
+// the usual alternative: blocking `pread`s on a thread pool, each read posting the next from its worker
+BENCHMARK_CASE("proactor/random tmpfs reads/blocking thread pool")
+{
+  tmpfs_file file;
+  struct shared
+  {
+    const tmpfs_file* file;
+    clock::time_point until;
+    std::atomic<std::uint64_t> completed{ 0 };
+  } reading{ &file, deadline(state) };
+  auto start = clock::now();
+  {
+    tmf::thread_pool<> pool;
+    struct reader
+    {
+      void operator()() const
+      {
+        alignas(64) char buffer[block];
+        std::uint64_t random = seed;
+        if (::pread(reading->file->fd, buffer, block, next_offset(random)) == static_cast<ssize_t>(block)) {
+          reading->completed.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (clock::now() < reading->until) {
+          pool->post(reader{ pool, reading, random });
+        }
+      }
+
+      tmf::thread_pool<>* pool;
+      shared* reading;
+      std::uint64_t seed;
+    };
+    for (std::size_t index = 0; index < in_flight; ++index) {
+      pool.post(reader{ &pool, &reading, index + 1 });
+    }
+  }
+  auto seconds = std::chrono::duration<double>(clock::now() - start).count();
+  state.record("4 KiB reads", static_cast<double>(reading.completed.load()) / seconds / 1e3, "kread/s");
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "framework/benchmark.hpp"
+
+#include <reactor.hpp>
+
+#if defined(__linux__)
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t pairs = 64;
+constexpr std::size_t in_flight = 8;
+
+using clock = std::chrono::steady_clock;
+
+// the loop the reactor replaces: handlers as `std::function`s looked up in a map by descriptor
+struct map_reactor
+{
+  map_reactor()
+    : epoll(::epoll_create1(EPOLL_CLOEXEC))
+  {}
+
+  ~map_reactor() { ::close(epoll); }
+
+  void add(int fd, std::function<void(int, std::uint32_t)> on_read)
+  {
+    epoll_event interest{};
+    interest.events = EPOLLIN | EPOLLET;
+    interest.data.fd = fd;
+    ::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &interest);
+    handlers[fd] = std::move(on_read);
+  }
+
+  std::size_t run_once(int timeout_milliseconds)
+  {
+    auto ready = ::epoll_wait(epoll, events, 64, timeout_milliseconds);
+    for (int index = 0; index < ready; ++index) {
+      handlers.at(events[index].data.fd)(events[index].data.fd, events[index].events);
+    }
+    return ready < 0 ? 0 : static_cast<std::size_t>(ready);
+  }
+
+  int epoll;
+  epoll_event events[64];
+  std::unordered_map<int, std::function<void(int, std::uint32_t)>> handlers;
+};
+
+// `pairs` socketpairs in a ring with `in_flight` timestamps passed along it: each read handler takes the
+// timestamps written to its socket, records how long they took to be dispatched and writes fresh ones to the next
+// socket of the ring
+struct ring
+{
+  ring()
+  {
+    for (auto& pair : sockets) {
+      ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair.ends);
+    }
+    latencies.reserve(1 << 22);
+  }
+
+  ~ring()
+  {
+    for (auto& pair : sockets) {
+      ::close(pair.ends[0]);
+      ::close(pair.ends[1]);
+    }
+  }
+
+  void send(std::size_t index)
+  {
+    auto sent = clock::now().time_since_epoch().count();
+    (void)!::write(sockets[index % pairs].ends[1], &sent, sizeof(sent));
+  }
+
+  void on_read(std::size_t index, int fd)
+  {
+    clock::rep sent[in_flight];
+    for (ssize_t count; (count = ::read(fd, sent, sizeof(sent))) > 0;) {
+      auto received = clock::now().time_since_epoch().count();
+      for (std::size_t token = 0; token < static_cast<std::size_t>(count) / sizeof(clock::rep); ++token) {
+        if (latencies.size() < latencies.capacity()) {
+          latencies.push_back(static_cast<double>(received - sent[token]));
+        }
+        ++dispatched;
+        send(index + 1);
+      }
+    }
+  }
+
+  struct pair
+  {
+    int ends[2];
+  };
+
+  pair sockets[pairs];
+  std::uint64_t dispatched = 0;
+  std::vector<double> latencies;
+};
+
+template<typename LoopT>
+void
+ring_of_sockets(bench::state& state, LoopT& loop)
+{
+  ring passing;
+  for (std::size_t index = 0; index < pairs; ++index) {
+    loop.add(passing.sockets[index].ends[0],
+             [&passing, index](int fd, std::uint32_t) { passing.on_read(index, fd); });
+  }
+  for (std::size_t token = 0; token < in_flight; ++token) {
+    passing.send(token * (pairs / in_flight));
+  }
+  auto start = clock::now();
+  auto until = start + std::chrono::duration<double>(state.settings().min_seconds * 4);
+  while (clock::now() < until) {
+    loop.run_once(1000);
+  }
+  auto seconds = std::chrono::duration<double>(clock::now() - start).count();
+  auto& latencies = passing.latencies;
+  auto percentile = [&latencies](double fraction) {
+    auto at = latencies.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(latencies.size() - 1));
+    std::nth_element(latencies.begin(), at, latencies.end());
+    return *at;
+  };
+  state.record("events", static_cast<double>(passing.dispatched) / seconds / 1e3, "kevent/s");
+  state.record("p50 dispatch latency", percentile(0.5) / 1e3, "us");
+  state.record("p99 dispatch latency", percentile(0.99) / 1e3, "us");
+}
+
+}
+
+BENCHMARK_CASE("reactor/ring of socketpairs/tmf::reactor")
+{
+  tmf::reactor<> loop{ 1024 };
+  ring_of_sockets(state, loop);
+}
+
+BENCHMARK_CASE("reactor/ring of socketpairs/std::function map")
+{
+  map_reactor loop;
+  ring_of_sockets(state, loop);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "framework/benchmark.hpp"
+
+#include <signal.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t resident_slots = 8;
+
+// the hand-rolled observer list the signal replaces
+struct locked_observers
+{
+  using slot_type = tmf::callable<void(std::uint64_t)>;
+
+  std::size_t subscribe(slot_type slot)
+  {
+    std::lock_guard<std::mutex> lock{ mutex };
+    slots.push_back(std::move(slot));
+    return slots.size() - 1;
+  }
+
+  void unsubscribe(std::size_t index)
+  {
+    std::lock_guard<std::mutex> lock{ mutex };
+    slots.erase(slots.begin() + static_cast<std::ptrdiff_t>(index));
+  }
+
+  void emit(std::uint64_t value)
+  {
+    std::lock_guard<std::mutex> lock{ mutex };
+    for (auto& slot : slots) {
+      slot(value);
+    }
+  }
+
+  std::mutex mutex;
+  std::vector<slot_type> slots;
+};
+
+struct alignas(64) sink
+{
+  std::uint64_t total = 0;
+};
+
+// emitters emit as fast as they can while one extra thread subscribes and unsubscribes a slot in a loop
+template<typename SignalT, typename SubscribeT, typename UnsubscribeT>
+void
+churn(bench::state& state, std::size_t emitters, SignalT& subject, SubscribeT subscribe, UnsubscribeT unsubscribe)
+{
+  std::vector<sink> sinks(resident_slots + 1);
+  for (std::size_t index = 0; index < resident_slots; ++index) {
+    subscribe([&total = sinks[index].total](std::uint64_t value) { total += value; });
+  }
+  std::vector<std::uint64_t> emitted(emitters);
+  std::atomic<std::uint64_t> churned{ 0 };
+  auto seconds = bench::run_concurrently(emitters + 1, state.settings().min_seconds * 4, [&](auto index, auto& running) {
+    if (index == emitters) {
+      while (running.load(std::memory_order_relaxed)) {
+        unsubscribe(subscribe([&total = sinks[resident_slots].total](std::uint64_t value) { total += value; }));
+        churned.fetch_add(1, std::memory_order_relaxed);
+      }
+      return;
+    }
+    std::uint64_t count = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      subject.emit(1);
+      ++count;
+    }
+    emitted[index] = count;
+  });
+  std::uint64_t total = 0;
+  for (auto count : emitted) {
+    total += count;
+  }
+  state.record(std::to_string(emitters) + " emitters", static_cast<double>(total) / seconds / 1e6, "Memit/s");
+  state.record(std::to_string(emitters) + " emitters churn", static_cast<double>(churned) / seconds / 1e6, "Msub/s");
+}
+
+}
+
+BENCHMARK_CASE("signal/emit while churning/tmf::signal")
+{
+  for (std::size_t emitters : { 1, 2, 4, 8 }) {
+    tmf::signal<void(std::uint64_t)> subject;
+    churn(
+      state,
+      emitters,
+      subject,
+      [&](auto slot) { return subject.subscribe(std::move(slot)); },
+      [&](auto subscription) { subject.unsubscribe(subscription); });
+  }
+}
+
+BENCHMARK_CASE("signal/emit while churning/mutex observer list")
+{
+  for (std::size_t emitters : { 1, 2, 4, 8 }) {
+    locked_observers subject;
+    churn(
+      state,
+      emitters,
+      subject,
+      [&](auto slot) { return subject.subscribe(std::move(slot)); },
+      [&](auto index) { subject.unsubscribe(index); });
+  }
+}
+
+BENCHMARK_CASE("signal/emit/tmf::signal")
+{
+  tmf::signal<void(std::uint64_t)> subject;
+  std::vector<sink> sinks(resident_slots);
+  for (auto& slot_sink : sinks) {
+    subject.subscribe([&total = slot_sink.total](std::uint64_t value) { total += value; });
+  }
+  state.measure("emit", [&] { subject.emit(1); });
+}
+
+BENCHMARK_CASE("signal/emit/mutex observer list")
+{
+  locked_observers subject;
+  std::vector<sink> sinks(resident_slots);
+  for (auto& slot_sink : sinks) {
+    subject.subscribe([&total = slot_sink.total](std::uint64_t value) { total += value; });
+  }
+  state.measure("emit", [&] { subject.emit(1); });
+}
\ No newline at end of file
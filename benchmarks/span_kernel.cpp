@@ -0,0 +1,74 @@
+#include "framework/benchmark.hpp"
+
+#include <span_kernel.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t element_count = 4096;
+
+struct affine
+{
+  float operator()(float value) const { return value * scale + offset; }
+  float scale;
+  float offset;
+};
+
+float
+clamp_unit(float value)
+{
+  return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+template<typename T, typename SourceT>
+void
+compare(bench::state& state, SourceT source)
+{
+  std::vector<T> input(element_count);
+  std::iota(input.begin(), input.end(), T{ 1 });
+  std::vector<T> output(element_count);
+  // the transforms are picked at runtime, so both paths go through type erasure
+  tmf::callable<T(T)> scalar{ source };
+  tmf::span_kernel<T(T)> kernel{ source };
+  state.measure(
+    "per element",
+    [&] {
+      for (std::size_t index = 0; index < element_count; ++index) {
+        output[index] = scalar(input[index]);
+      }
+      bench::do_not_optimize(output.data());
+    },
+    element_count);
+  state.measure(
+    "span kernel",
+    [&] {
+      kernel(input, output);
+      bench::do_not_optimize(output.data());
+    },
+    element_count);
+}
+
+}
+
+BENCHMARK_CASE("span kernel/float lambda")
+{
+  compare<float>(state, [](float value) { return value * 0.5f + 1.0f; });
+}
+
+BENCHMARK_CASE("span kernel/float functor")
+{
+  compare<float>(state, affine{ 2.0f, -1.0f });
+}
+
+BENCHMARK_CASE("span kernel/float function pointer")
+{
+  compare<float>(state, &clamp_unit);
+}
+
+BENCHMARK_CASE("span kernel/int lambda")
+{
+  compare<std::int32_t>(state, [](std::int32_t value) { return (value ^ 0x5a5a) * 3 + 7; });
+}
\ No newline at end of file
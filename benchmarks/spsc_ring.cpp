@@ -0,0 +1,88 @@
+#include "framework/benchmark.hpp"
+
+#include <mpmc_queue.hpp>
+#include <spsc_ring.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+constexpr std::size_t ring_bytes = 64 * 1024;
+
+// a log record the size of `Words` machine words, as captured by a telemetry call site
+template<std::size_t Words>
+struct record
+{
+  void operator()() { *sink += fields[0] + fields[Words - 1]; }
+
+  std::uint64_t* sink;
+  std::array<std::uint64_t, Words> fields;
+};
+
+// one thread produces records of mixed size, another consumes them
+template<typename PushT, typename PopT>
+void
+pipeline(bench::state& state, const std::string& name, PushT push, PopT pop)
+{
+  std::uint64_t total = 0;
+  std::uint64_t consumed = 0;
+  auto seconds = bench::run_concurrently(2, state.settings().min_seconds * 2, [&](std::size_t index, auto& running) {
+    if (index == 0) {
+      for (std::uint64_t produced = 0; running.load(std::memory_order_relaxed); ++produced) {
+        switch (produced % 4) {
+          case 0:
+            while (!push(record<1>{ &total, { produced } }) && running.load(std::memory_order_relaxed)) {
+            }
+            break;
+          case 1:
+            while (!push(record<4>{ &total, { produced } }) && running.load(std::memory_order_relaxed)) {
+            }
+            break;
+          default:
+            while (!push(record<2>{ &total, { produced } }) && running.load(std::memory_order_relaxed)) {
+            }
+            break;
+        }
+      }
+    } else {
+      while (running.load(std::memory_order_relaxed)) {
+        consumed += pop();
+      }
+    }
+  });
+  state.record(name, static_cast<double>(consumed) / seconds / 1e6, "Mtask/s");
+}
+
+}
+
+BENCHMARK_CASE("spsc ring/mixed records/tmf::spsc_ring")
+{
+  tmf::spsc_ring<ring_bytes> ring;
+  pipeline(
+    state, "throughput", [&](auto task) { return ring.try_push(std::move(task)); }, [&] { return ring.drain(); });
+  state.record("entry bytes (1 word)", tmf::spsc_ring<ring_bytes>::entry_size<record<1>>(), "B");
+  state.record("entry bytes (4 words)", tmf::spsc_ring<ring_bytes>::entry_size<record<4>>(), "B");
+}
+
+BENCHMARK_CASE("spsc ring/mixed records/tmf::mpmc_queue")
+{
+  // fixed cells have to fit the largest record
+  using queue_type = tmf::mpmc_queue<ring_bytes / 128, 48>;
+  static queue_type queue;
+  queue_type::task_type task;
+  pipeline(
+    state,
+    "throughput",
+    [&](auto record) { return queue.try_emplace(std::move(record)); },
+    [&]() -> std::size_t {
+      std::size_t ran = 0;
+      while (queue.try_pop(task)) {
+        task();
+        ++ran;
+      }
+      return ran;
+    });
+  state.record("cell bytes", sizeof(queue_type) / queue_type::length(), "B");
+}
\ No newline at end of file
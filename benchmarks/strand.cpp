@@ -0,0 +1,108 @@
+#include "framework/benchmark.hpp"
+
+#include <strand.hpp>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using pool_type = tmf::thread_pool<4096>;
+
+constexpr std::size_t connections = 64;
+constexpr std::size_t messages = 256;
+constexpr std::size_t workers = 4;
+
+// per connection state that must only be touched by one thread at a time
+struct connection_state
+{
+  std::uint64_t bytes = 0;
+  std::uint64_t messages = 0;
+};
+
+struct strand_connection
+{
+  explicit strand_connection(pool_type& pool)
+    : serial(pool)
+  {}
+
+  tmf::strand<pool_type> serial;
+  connection_state state;
+};
+
+struct locked_connection
+{
+  std::mutex mutex;
+  connection_state state;
+};
+
+// every connection receives a burst of messages from the thread that accepted them, the caller waits until all
+// have been handled
+template<typename PostT>
+void
+deliver(std::atomic<std::size_t>& handled, PostT post)
+{
+  handled.store(0, std::memory_order_relaxed);
+  for (std::size_t message = 0; message < messages; ++message) {
+    for (std::size_t connection = 0; connection < connections; ++connection) {
+      post(connection, message);
+    }
+  }
+  while (handled.load(std::memory_order_acquire) != connections * messages) {
+    std::this_thread::yield();
+  }
+}
+
+}
+
+BENCHMARK_CASE("strand/64 connections/tmf::strand")
+{
+  pool_type pool{ workers };
+  std::vector<std::unique_ptr<strand_connection>> open;
+  for (std::size_t connection = 0; connection < connections; ++connection) {
+    open.push_back(std::make_unique<strand_connection>(pool));
+  }
+  std::atomic<std::size_t> handled{ 0 };
+  state.measure(
+    "per message",
+    [&] {
+      deliver(handled, [&](std::size_t connection, std::size_t message) {
+        auto target = open[connection].get();
+        target->serial.post([target, &handled, message] {
+          target->state.bytes += message;
+          ++target->state.messages;
+          handled.fetch_add(1, std::memory_order_release);
+        });
+      });
+    },
+    connections * messages);
+}
+
+BENCHMARK_CASE("strand/64 connections/mutex per connection")
+{
+  pool_type pool{ workers };
+  std::vector<std::unique_ptr<locked_connection>> open;
+  for (std::size_t connection = 0; connection < connections; ++connection) {
+    open.push_back(std::make_unique<locked_connection>());
+  }
+  std::atomic<std::size_t> handled{ 0 };
+  state.measure(
+    "per message",
+    [&] {
+      deliver(handled, [&](std::size_t connection, std::size_t message) {
+        auto target = open[connection].get();
+        pool.post([target, &handled, message] {
+          std::lock_guard<std::mutex> lock{ target->mutex };
+          target->state.bytes += message;
+          ++target->state.messages;
+          handled.fetch_add(1, std::memory_order_release);
+        });
+      });
+    },
+    connections * messages);
+}
\ No newline at end of file
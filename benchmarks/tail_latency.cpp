@@ -0,0 +1,153 @@
+#include "framework/benchmark.hpp"
+#include "framework/latency.hpp"
+
+#include <callable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// far beyond any last level cache once the targets behind them are counted
+constexpr std::size_t population = std::size_t{ 1 } << 20;
+
+// distinct handler types, each with trampolines of its own
+constexpr std::size_t kinds = 16;
+
+template<std::size_t Kind>
+struct handler
+{
+  std::uint64_t operator()(std::uint64_t value) const
+  {
+    std::uint64_t mixed = value ^ Kind;
+    for (auto word : state) {
+      mixed = mixed * 31 + word;
+    }
+    return mixed;
+  }
+
+  // one to three words, so targets fill the storage to different depths
+  std::uint64_t state[1 + Kind % 3] = {};
+};
+
+// `HandlerT` is deduced the way a `callable` constructor deduces its target, which is kept by reference when it is
+// passed as an lvalue. every function of the population has to own its handler, or it calls into a dead frame
+template<typename FunctionT, typename HandlerT>
+void
+emplace_owned(std::vector<FunctionT>& into, HandlerT&& made)
+{
+  static_assert(
+    !std::is_reference_v<decltype(tmf::stored_functor_t<HandlerT, std::uint64_t, std::uint64_t>::m_object)>,
+    "handlers must be moved into the population");
+  into.emplace_back(std::forward<HandlerT>(made));
+}
+
+template<typename FunctionT, std::size_t Kind>
+void
+emplace_handler(std::vector<FunctionT>& into, std::uint64_t seed)
+{
+  handler<Kind> made;
+  std::fill(std::begin(made.state), std::end(made.state), seed);
+  emplace_owned(into, std::move(made));
+}
+
+// the population, with kinds picked at random
+template<typename FunctionT, std::size_t... Kinds>
+void
+populate(std::vector<FunctionT>& functions, std::index_sequence<Kinds...>)
+{
+  static constexpr void (*factories[])(std::vector<FunctionT>&, std::uint64_t) = { &emplace_handler<FunctionT,
+                                                                                                     Kinds>... };
+  std::mt19937_64 random{ 42 };
+  functions.reserve(population);
+  for (std::size_t index = 0; index < population; ++index) {
+    auto seed = random();
+    factories[seed % kinds](functions, seed);
+  }
+}
+
+// the order every thread calls the population in, starting from an offset of its own
+const std::vector<std::uint32_t>&
+call_order()
+{
+  static const auto order = [] {
+    std::vector<std::uint32_t> indices(population);
+    for (std::size_t index = 0; index < population; ++index) {
+      indices[index] = static_cast<std::uint32_t>(index);
+    }
+    std::shuffle(indices.begin(), indices.end(), std::mt19937_64{ 7 });
+    return indices;
+  }();
+  return order;
+}
+
+// times every call of a randomly ordered walk over a population of handlers from every hardware thread, and
+// reports the tail of the merged distribution. each call is timed on its own, so the figures include the cost
+// of reading the clock, which is reported alongside as "timer overhead"
+template<typename FunctionT>
+void
+tail_latency(bench::state& state)
+{
+  std::vector<FunctionT> functions;
+  populate(functions, std::make_index_sequence<kinds>{});
+  auto& order = call_order();
+  auto threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  std::vector<bench::latency_histogram> histograms(threads);
+  std::vector<std::uint64_t> sinks(threads);
+  bench::tick_clock::nanoseconds();
+
+  bench::run_concurrently(threads, state.settings().min_seconds * 10, [&](std::size_t thread, auto& running) {
+    auto& histogram = histograms[thread];
+    std::uint64_t sink = 0;
+    auto position = thread * (population / threads);
+    while (running.load(std::memory_order_relaxed)) {
+      for (std::size_t call = 0; call < 4096; ++call) {
+        auto& function = functions[order[position]];
+        position = position + 1 == population ? 0 : position + 1;
+        auto start = bench::tick_clock::start();
+        sink += function(sink);
+        histogram.record(bench::tick_clock::stop() - start);
+      }
+    }
+    sinks[thread] = sink;
+  });
+  bench::do_not_optimize(sinks);
+
+  bench::latency_histogram merged;
+  for (auto& histogram : histograms) {
+    merged.merge(histogram);
+  }
+  bench::latency_histogram overhead;
+  for (std::size_t sample = 0; sample < 100000; ++sample) {
+    auto start = bench::tick_clock::start();
+    bench::clobber_memory();
+    overhead.record(bench::tick_clock::stop() - start);
+  }
+
+  auto nanoseconds = [](std::uint64_t ticks) { return static_cast<double>(ticks) * bench::tick_clock::nanoseconds(); };
+  state.record("p50", nanoseconds(merged.percentile(0.5)), "ns");
+  state.record("p99", nanoseconds(merged.percentile(0.99)), "ns");
+  state.record("p99.9", nanoseconds(merged.percentile(0.999)), "ns");
+  state.record("max", nanoseconds(merged.max()), "ns");
+  state.record("calls", static_cast<double>(merged.count()), "calls");
+  state.record("timer overhead", nanoseconds(overhead.percentile(0.5)), "ns");
+}
+
+}
+
+BENCHMARK_CASE("tail latency/1M cold handlers of 16 types/tmf::callable")
+{
+  tail_latency<tmf::callable<std::uint64_t(std::uint64_t)>>(state);
+}
+
+BENCHMARK_CASE("tail latency/1M cold handlers of 16 types/std::function")
+{
+  tail_latency<std::function<std::uint64_t(std::uint64_t)>>(state);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "framework/benchmark.hpp"
+
+#include <task.hpp>
+
+#include <functional>
+
+namespace {
+
+// a request handler split in three stages, each handing its result to the next
+struct request
+{
+  int id;
+  long payload[3];
+};
+
+tmf::task<long>
+parse(const request& incoming)
+{
+  co_return incoming.payload[0] + incoming.id;
+}
+
+tmf::task<long>
+lookup(const request& incoming)
+{
+  auto key = co_await parse(incoming);
+  co_return key * 2 + incoming.payload[1];
+}
+
+tmf::task<long>
+respond(const request& incoming)
+{
+  auto value = co_await lookup(incoming);
+  co_return value + incoming.payload[2];
+}
+
+// the same stages chained through `std::function` callbacks, each capturing the request
+void
+parse(const request& incoming, std::function<void(long)> done)
+{
+  done(incoming.payload[0] + incoming.id);
+}
+
+void
+lookup(const request& incoming, std::function<void(long)> done)
+{
+  parse(incoming, [incoming, done](long key) { done(key * 2 + incoming.payload[1]); });
+}
+
+void
+respond(const request& incoming, std::function<void(long)> done)
+{
+  lookup(incoming, [incoming, done](long value) { done(value + incoming.payload[2]); });
+}
+
+}
+
+BENCHMARK_CASE("task/three stage handler/tmf::task")
+{
+  request incoming{ 1, { 2, 3, 4 } };
+  state.measure("per request", [&] {
+    auto handler = respond(incoming);
+    handler.start();
+    bench::do_not_optimize(handler.result());
+  });
+}
+
+BENCHMARK_CASE("task/three stage handler/std::function callbacks")
+{
+  request incoming{ 1, { 2, 3, 4 } };
+  state.measure("per request", [&] {
+    long result = 0;
+    respond(incoming, [&result](long value) { result = value; });
+    bench::do_not_optimize(result);
+  });
+}
\ No newline at end of file
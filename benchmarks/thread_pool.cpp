@@ -0,0 +1,181 @@
+#include "framework/benchmark.hpp"
+
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// the mutex protected `std::function` pool the executor replaces, with one shared queue and no stealing
+class locked_pool
+{
+public:
+  explicit locked_pool(std::size_t threads)
+  {
+    for (std::size_t index = 0; index < threads; ++index) {
+      workers.emplace_back([this] {
+        std::unique_lock<std::mutex> lock{ mutex };
+        for (;;) {
+          wakeup.wait(lock, [this] { return stopping || !tasks.empty(); });
+          if (tasks.empty()) {
+            return;
+          }
+          auto task = std::move(tasks.front());
+          tasks.pop_front();
+          lock.unlock();
+          task();
+          lock.lock();
+        }
+      });
+    }
+  }
+
+  ~locked_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock{ mutex };
+      stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  template<typename SourceT>
+  void post(SourceT&& source)
+  {
+    {
+      std::lock_guard<std::mutex> lock{ mutex };
+      tasks.emplace_back(std::forward<SourceT>(source));
+    }
+    wakeup.notify_one();
+  }
+
+  bool run_one()
+  {
+    std::unique_lock<std::mutex> lock{ mutex };
+    if (tasks.empty()) {
+      return false;
+    }
+    auto task = std::move(tasks.front());
+    tasks.pop_front();
+    lock.unlock();
+    task();
+    return true;
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::deque<std::function<void()>> tasks;
+  std::vector<std::thread> workers;
+  bool stopping = false;
+};
+
+template<typename PoolT>
+void
+join(PoolT& pool, const std::atomic<bool>& done)
+{
+  while (!done.load(std::memory_order_acquire)) {
+    if (!pool.run_one()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// forks one half of every call and computes the other inline, so each fork is a tiny task
+template<typename PoolT>
+std::uint64_t
+fibonacci(PoolT& pool, int number)
+{
+  if (number < 2) {
+    return static_cast<std::uint64_t>(number);
+  }
+  struct half
+  {
+    std::uint64_t result;
+    std::atomic<bool> done;
+  } posted{ 0, { false } };
+  pool.post([&pool, &posted, number] {
+    posted.result = fibonacci(pool, number - 1);
+    posted.done.store(true, std::memory_order_release);
+  });
+  auto inline_result = fibonacci(pool, number - 2);
+  join(pool, posted.done);
+  return posted.result + inline_result;
+}
+
+constexpr std::size_t
+forks(int number)
+{
+  return number < 2 ? 0 : 1 + forks(number - 1) + forks(number - 2);
+}
+
+// splits the range in halves down to `grain` elements, forking the left half each time
+template<typename PoolT>
+std::uint64_t
+sum(PoolT& pool, const std::uint64_t* first, std::size_t count)
+{
+  constexpr std::size_t grain = 4096;
+  if (count <= grain) {
+    return std::accumulate(first, first + count, std::uint64_t{ 0 });
+  }
+  // the forked half is described on this stack frame so the task only captures two pointers
+  struct half
+  {
+    const std::uint64_t* first;
+    std::size_t count;
+    std::uint64_t result;
+    std::atomic<bool> done;
+  } left{ first, count / 2, 0, { false } };
+  pool.post([&pool, &left] {
+    left.result = sum(pool, left.first, left.count);
+    left.done.store(true, std::memory_order_release);
+  });
+  auto right = sum(pool, first + left.count, count - left.count);
+  join(pool, left.done);
+  return left.result + right;
+}
+
+template<typename PoolT>
+void
+fork_join(bench::state& state)
+{
+  constexpr int fibonacci_number = 20;
+  std::vector<std::uint64_t> values(std::size_t{ 1 } << 22);
+  std::iota(values.begin(), values.end(), std::uint64_t{ 0 });
+  for (std::size_t threads : { 1, 2, 4, 8 }) {
+    PoolT pool{ threads };
+    auto suffix = " (" + std::to_string(threads) + " threads)";
+    state.measure(
+      "fib per fork" + suffix,
+      [&] { bench::do_not_optimize(fibonacci(pool, fibonacci_number)); },
+      forks(fibonacci_number));
+    state.measure(
+      "parallel sum per element" + suffix,
+      [&] { bench::do_not_optimize(sum(pool, values.data(), values.size())); },
+      values.size());
+  }
+}
+
+}
+
+BENCHMARK_CASE("thread pool/fork join/tmf::thread_pool")
+{
+  fork_join<tmf::thread_pool<>>(state);
+}
+
+BENCHMARK_CASE("thread pool/fork join/mutex std::function pool")
+{
+  fork_join<locked_pool>(state);
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "framework/benchmark.hpp"
+
+#include <timer_wheel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t timers = 100000;
+
+// the `std::priority_queue` of `std::function` the wheel replaces, cancelled timers are flagged and skipped when
+// they reach the top
+class heap_timers
+{
+public:
+  std::size_t schedule(std::uint64_t deadline, std::function<void()> callback)
+  {
+    auto id = cancelled.size();
+    cancelled.push_back(false);
+    queue.push(entry{ deadline, id, std::move(callback) });
+    return id;
+  }
+
+  void cancel(std::size_t id) { cancelled[id] = true; }
+
+  void advance(std::uint64_t now)
+  {
+    while (!queue.empty() && queue.top().deadline <= now) {
+      auto callback = std::move(const_cast<entry&>(queue.top()).callback);
+      auto id = queue.top().id;
+      queue.pop();
+      if (!cancelled[id]) {
+        callback();
+      }
+    }
+  }
+
+  bool empty() const { return queue.empty(); }
+
+private:
+  struct entry
+  {
+    std::uint64_t deadline;
+    std::size_t id;
+    std::function<void()> callback;
+
+    bool operator>(const entry& rhs) const { return deadline > rhs.deadline; }
+  };
+
+  std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+  std::vector<bool> cancelled;
+};
+
+// timeouts spread over ten seconds of millisecond ticks, in a fixed pseudo random order
+std::vector<std::uint64_t>
+delays()
+{
+  std::vector<std::uint64_t> result(timers);
+  std::uint32_t random = 2463534242u;
+  for (auto& delay : result) {
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    delay = 1 + random % 10000;
+  }
+  return result;
+}
+
+// a timeout callback carries a few words of context, more than `std::function` keeps inline
+struct timeout
+{
+  void operator()() const { *fired += connection + generation; }
+
+  std::uint64_t* fired;
+  std::uint64_t connection;
+  std::uint64_t generation;
+};
+
+}
+
+BENCHMARK_CASE("timer wheel/100k timeouts/tmf::timer_wheel")
+{
+  using wheel_type = tmf::timer_wheel<>;
+  auto offsets = delays();
+  std::uint64_t fired = 0;
+  auto start = wheel_type::clock::time_point{};
+  state.measure(
+    "schedule and fire",
+    [&] {
+      wheel_type wheel{ timers, std::chrono::milliseconds{ 1 }, start };
+      for (std::size_t index = 0; index < timers; ++index) {
+        wheel.schedule_at(start + std::chrono::milliseconds{ offsets[index] }, timeout{ &fired, index, 1 });
+      }
+      wheel.advance(start + std::chrono::milliseconds{ 10000 });
+    },
+    timers);
+  state.measure(
+    "schedule and cancel",
+    [&] {
+      wheel_type wheel{ timers, std::chrono::milliseconds{ 1 }, start };
+      std::vector<wheel_type::timer> scheduled(timers);
+      for (std::size_t index = 0; index < timers; ++index) {
+        scheduled[index] =
+          wheel.schedule_at(start + std::chrono::milliseconds{ offsets[index] }, timeout{ &fired, index, 1 });
+      }
+      for (auto handle : scheduled) {
+        wheel.cancel(handle);
+      }
+      wheel.advance(start + std::chrono::milliseconds{ 10000 });
+    },
+    timers);
+  bench::do_not_optimize(fired);
+}
+
+BENCHMARK_CASE("timer wheel/100k timeouts/std::priority_queue of std::function")
+{
+  auto offsets = delays();
+  std::uint64_t fired = 0;
+  state.measure(
+    "schedule and fire",
+    [&] {
+      heap_timers heap;
+      for (std::size_t index = 0; index < timers; ++index) {
+        heap.schedule(offsets[index], timeout{ &fired, index, 1 });
+      }
+      heap.advance(10000);
+    },
+    timers);
+  state.measure(
+    "schedule and cancel",
+    [&] {
+      heap_timers heap;
+      std::vector<std::size_t> scheduled(timers);
+      for (std::size_t index = 0; index < timers; ++index) {
+        scheduled[index] = heap.schedule(offsets[index], timeout{ &fired, index, 1 });
+      }
+      for (auto id : scheduled) {
+        heap.cancel(id);
+      }
+      heap.advance(10000);
+    },
+    timers);
+  bench::do_not_optimize(fired);
+}
\ No newline at end of file
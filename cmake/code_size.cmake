@@ -0,0 +1,94 @@
+# reports the code generated per target type of `tmf::callable`, and fails when any of them exceeds a limit.
+# every symbol of the `bind<ConcreteT>` lambdas (the trampolines a callable dispatches through) is summed per
+# instantiation of `bind`, which is one per signature, capacity and target type
+#
+# usage: cmake -DNM=path -DOBJECTS=file[;file...] -DLIMIT=bytes -P code_size.cmake
+
+if(NOT NM OR NOT OBJECTS OR NOT LIMIT)
+  message(FATAL_ERROR "usage: cmake -DNM=path -DOBJECTS=file[;file...] -DLIMIT=bytes -P code_size.cmake")
+endif()
+
+execute_process(
+  COMMAND ${NM} --demangle --print-size --size-sort ${OBJECTS}
+  OUTPUT_VARIABLE symbols
+  RESULT_VARIABLE status)
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "${NM} failed with ${status}")
+endif()
+
+# one list entry per line, with the characters lists and regular expressions treat specially replaced
+string(REPLACE "[" "<open>" symbols "${symbols}")
+string(REPLACE "]" "<close>" symbols "${symbols}")
+string(REPLACE ";" "<semicolon>" symbols "${symbols}")
+string(REPLACE "\n" ";" symbols "${symbols}")
+
+set(instantiations "")
+foreach(line IN LISTS symbols)
+  # address, size, type and name; only code counts
+  if(NOT line MATCHES "^[0-9a-f]+ ([0-9a-f]+) [tTwW] (.*)$")
+    continue()
+  endif()
+  set(size "${CMAKE_MATCH_1}")
+  set(name "${CMAKE_MATCH_2}")
+  string(FIND "${name}" ">()::{lambda" end)
+  if(end EQUAL -1)
+    continue()
+  endif()
+  string(SUBSTRING "${name}" 0 ${end} prefix)
+  string(FIND "${prefix}" "tmf::callable<" start REVERSE)
+  if(start EQUAL -1)
+    continue()
+  endif()
+  math(EXPR length "${end} + 1 - ${start}")
+  string(SUBSTRING "${name}" ${start} ${length} instantiation)
+  string(MD5 key "${instantiation}")
+  math(EXPR bytes "0x${size}")
+  if(NOT DEFINED bytes_${key})
+    set(bytes_${key} 0)
+    set(name_${key} "${instantiation}")
+    list(APPEND instantiations ${key})
+  endif()
+  math(EXPR bytes_${key} "${bytes_${key}} + ${bytes}")
+endforeach()
+
+list(LENGTH instantiations count)
+if(count EQUAL 0)
+  message(FATAL_ERROR "no `tmf::callable` trampolines found in ${OBJECTS}")
+endif()
+
+set(total 0)
+set(largest 0)
+set(report "")
+foreach(key IN LISTS instantiations)
+  math(EXPR total "${total} + ${bytes_${key}}")
+  if(bytes_${key} GREATER largest)
+    set(largest ${bytes_${key}})
+  endif()
+  # zero padded so the lines sort by size
+  string(LENGTH "${bytes_${key}}" digits)
+  math(EXPR padding "8 - ${digits}")
+  string(REPEAT "0" ${padding} zeros)
+  list(APPEND report "${zeros}${bytes_${key}} ${name_${key}}")
+endforeach()
+list(SORT report ORDER DESCENDING)
+
+set(over 0)
+foreach(line IN LISTS report)
+  string(REGEX REPLACE "^0*([0-9]+) (.*)$" "\\1" bytes "${line}")
+  string(REGEX REPLACE "^0*([0-9]+) (.*)$" "\\2" name "${line}")
+  string(REPLACE "<open>" "[" name "${name}")
+  string(REPLACE "<close>" "]" name "${name}")
+  string(REPLACE "<semicolon>" ";" name "${name}")
+  if(bytes GREATER LIMIT)
+    math(EXPR over "${over} + 1")
+    message("${bytes} bytes (over ${LIMIT}) ${name}")
+  else()
+    message("${bytes} bytes ${name}")
+  endif()
+endforeach()
+math(EXPR average "${total} / ${count}")
+message("${count} target types, ${total} bytes of trampolines, ${average} bytes on average, ${largest} at most")
+
+if(over GREATER 0)
+  message(FATAL_ERROR "${over} target types need more than ${LIMIT} bytes of trampolines")
+endif()
\ No newline at end of file
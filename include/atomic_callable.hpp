@@ -0,0 +1,61 @@
+#pragma once
+
+#include "callable.hpp"
+#include "epoch_domain.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+namespace tmf {
+
+template<typename, size_t = default_callable_capacity>
+struct atomic_callable;
+
+// a callable whose target can be replaced while other threads are calling it. calling is wait-free: it enters an
+// epoch and loads the current target. `store` publishes a new target and retires the old one once every call that
+// could still be using it has returned. stores are serialized and allocate the new target
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+struct atomic_callable<ReturnT(ArgTs...), Capacity>
+{
+  using target_type = callable<ReturnT(ArgTs...), Capacity>;
+  using this_type = atomic_callable<ReturnT(ArgTs...), Capacity>;
+
+  // start without a target
+  atomic_callable() noexcept;
+
+  // start with a target built from `sources`, taking any sources a `callable` can be constructed with
+  template<typename SourceT,
+           typename... SourceTs,
+           typename = std::enable_if_t<!std::is_same<std::decay_t<SourceT>, this_type>::value>>
+  explicit atomic_callable(SourceT&& source, SourceTs&&... sources);
+
+  atomic_callable(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // there must be no call in progress
+  ~atomic_callable();
+
+  // replace the target with one built from `sources`, or clear it if there are none. calls already underway
+  // finish with the old target
+  template<typename... SourceTs>
+  void store(SourceTs&&... sources);
+
+  // a copy of the current target
+  target_type load() const;
+
+  // call the current target, throws if there is none
+  ReturnT operator()(ArgTs... arguments) const;
+
+  // check if there is a target
+  bool empty() const;
+
+private:
+  epoch_domain m_domain;
+  std::atomic<target_type*> m_target;
+  std::mutex m_writer;
+};
+}
+
+#include "atomic_callable.inl"
\ No newline at end of file
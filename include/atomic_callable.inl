@@ -0,0 +1,65 @@
+#pragma once
+
+namespace tmf {
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+atomic_callable<ReturnT(ArgTs...), Capacity>::atomic_callable() noexcept
+  : m_target(nullptr)
+{}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+template<typename SourceT, typename... SourceTs, typename>
+atomic_callable<ReturnT(ArgTs...), Capacity>::atomic_callable(SourceT&& source, SourceTs&&... sources)
+  : m_target(new target_type{ std::forward<SourceT>(source), std::forward<SourceTs>(sources)... })
+{}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+atomic_callable<ReturnT(ArgTs...), Capacity>::~atomic_callable()
+{
+  delete m_target.load(std::memory_order_acquire);
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+template<typename... SourceTs>
+void
+atomic_callable<ReturnT(ArgTs...), Capacity>::store(SourceTs&&... sources)
+{
+  auto replacement = new target_type{ std::forward<SourceTs>(sources)... };
+  std::lock_guard<std::mutex> lock{ m_writer };
+  auto replaced = m_target.exchange(replacement, std::memory_order_acq_rel);
+  if (replaced != nullptr) {
+    m_domain.retire([replaced] { delete replaced; });
+  }
+  m_domain.collect();
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+typename atomic_callable<ReturnT(ArgTs...), Capacity>::target_type
+atomic_callable<ReturnT(ArgTs...), Capacity>::load() const
+{
+  auto reading = m_domain.enter();
+  auto current = m_target.load(std::memory_order_acquire);
+  return current == nullptr ? target_type{} : target_type{ static_cast<const target_type&>(*current) };
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+ReturnT
+atomic_callable<ReturnT(ArgTs...), Capacity>::operator()(ArgTs... arguments) const
+{
+  auto reading = m_domain.enter();
+  auto current = m_target.load(std::memory_order_acquire);
+  if (current == nullptr) {
+    throw callable_exception{ "attempted to call an empty callable." };
+  }
+  return static_cast<const target_type&>(*current)(static_cast<ArgTs>(arguments)...);
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+bool
+atomic_callable<ReturnT(ArgTs...), Capacity>::empty() const
+{
+  auto reading = m_domain.enter();
+  auto current = m_target.load(std::memory_order_acquire);
+  return current == nullptr || current->empty();
+}
+}
\ No newline at end of file
@@ -4,9 +4,32 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#include "type_name.hpp"
+
+#if defined(TMF_CALLABLE_STATS)
+#include "callable_stats.hpp"
+#endif
+
+#if defined(TMF_CALLABLE_TRACE)
+#include "callable_trace.hpp"
+#endif
+
+#if defined(TMF_CALLABLE_PROFILE)
+#include "callable_profile.hpp"
+#endif
+
+#if defined(TMF_CALLABLE_SIZES)
+#include "callable_sizes.hpp"
+#endif
+
 #define CALLABLE_ERROR                                                                                                 \
   "`tmf::callable` cannot hold a callable this large! Increasing "                                                     \
   "capacity might help; Or try decoupling state from functionality if "                                                \
@@ -22,6 +45,38 @@ struct callable_exception : std::runtime_error
 
 inline namespace detail {
 
+// stands in for the result of a batch call when the signature returns `void`
+struct batch_void
+{};
+
+template<typename ReturnT>
+struct batch_result
+{
+  using type = std::remove_cv_t<std::remove_reference_t<ReturnT>>;
+};
+
+template<>
+struct batch_result<void>
+{
+  using type = batch_void;
+};
+
+// element type of an argument column: by-value arguments are read from constant columns, references bind
+// straight to the column elements
+template<typename ArgT>
+struct batch_column
+{
+  using type = std::conditional_t<!std::is_reference_v<ArgT> && std::is_copy_constructible_v<ArgT>,
+                                  const ArgT,
+                                  std::remove_reference_t<ArgT>>;
+};
+
+template<typename ReturnT>
+using batch_result_t = typename batch_result<ReturnT>::type;
+
+template<typename ArgT>
+using batch_column_t = typename batch_column<ArgT>::type;
+
 template<typename ReturnT, typename... ArgTs>
 struct callable_base
 {
@@ -29,17 +84,56 @@ struct callable_base
   using caller_function_pointer = ReturnT (*)(bool, const callable_base<ReturnT, ArgTs...>*, ArgTs...);
   using copier_function_pointer = void (*)(callable_base<ReturnT, ArgTs...>&, const callable_base<ReturnT, ArgTs...>&);
   using mover_function_pointer = void (*)(callable_base<ReturnT, ArgTs...>&, callable_base<ReturnT, ArgTs...>&&);
+  // calls `count` times, reading arguments either from `rows` or (when `rows` is null) from `columns`
+  using batcher_function_pointer = void (*)(const callable_base<ReturnT, ArgTs...>*,
+                                            std::tuple<ArgTs...>*,
+                                            const std::tuple<batch_column_t<ArgTs>*...>*,
+                                            batch_result_t<ReturnT>*,
+                                            size_t);
+
+  // what copies, moves and batch calls of one concrete type go through. there is one static table per type, so
+  // these cost a callable a single pointer
+  struct operations
+  {
+    copier_function_pointer copier;
+    mover_function_pointer mover;
+    batcher_function_pointer batcher;
+  };
+};
+
+// a pointer to member function held at runtime, or fixed at compile time as an `std::integral_constant` so that
+// calls through it can be inlined
+template<typename MemPtrT>
+struct member_pointer
+{
+  static constexpr bool value = std::is_member_function_pointer_v<MemPtrT>;
+  static MemPtrT get(MemPtrT member) { return member; }
+};
+
+template<typename MemPtrT, MemPtrT Member>
+struct member_pointer<std::integral_constant<MemPtrT, Member>>
+{
+  static constexpr bool value = std::is_member_function_pointer_v<MemPtrT>;
+  static constexpr MemPtrT get(std::integral_constant<MemPtrT, Member>) { return Member; }
 };
 
 template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
 struct member_function final : callable_base<ReturnT, ArgTs...>
 {
-  template<typename FwdClassT, typename = std::enable_if_t<std::is_member_function_pointer_v<MemPtrT>>>
+  template<typename FwdClassT, typename = std::enable_if_t<member_pointer<MemPtrT>::value>>
   member_function(FwdClassT&& object, MemPtrT member)
     : m_object(std::forward<FwdClassT>(object))
     , m_member(member)
   {}
 
+  // calls through a copy of the held object, so constant and mutable sources are called alike
+  ReturnT call(ArgTs... arguments) const
+  {
+    auto source_object = m_object;
+    auto source_member = member_pointer<MemPtrT>::get(m_member);
+    return (source_object.*source_member)(static_cast<ArgTs>(arguments)...);
+  }
+
   ClassT m_object;
   MemPtrT m_member;
 };
@@ -47,12 +141,19 @@ struct member_function final : callable_base<ReturnT, ArgTs...>
 template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
 struct member_function_smart_pointer final : callable_base<ReturnT, ArgTs...>
 {
-  template<typename = std::enable_if_t<std::is_member_function_pointer_v<MemPtrT>>>
+  template<typename = std::enable_if_t<member_pointer<MemPtrT>::value>>
   member_function_smart_pointer(const std::shared_ptr<ClassT>& object, MemPtrT member)
     : m_object(object)
     , m_member(member)
   {}
 
+  ReturnT call(ArgTs... arguments) const
+  {
+    auto source_object = m_object;
+    auto source_member = member_pointer<MemPtrT>::get(m_member);
+    return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
+  }
+
   std::shared_ptr<ClassT> m_object;
   MemPtrT m_member;
 };
@@ -60,12 +161,19 @@ struct member_function_smart_pointer final : callable_base<ReturnT, ArgTs...>
 template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
 struct member_function_raw_pointer final : callable_base<ReturnT, ArgTs...>
 {
-  template<typename = std::enable_if_t<std::is_member_function_pointer_v<MemPtrT>>>
+  template<typename = std::enable_if_t<member_pointer<MemPtrT>::value>>
   member_function_raw_pointer(ClassT* object, MemPtrT member)
     : m_object(object)
     , m_member(member)
   {}
 
+  ReturnT call(ArgTs... arguments) const
+  {
+    auto source_object = m_object;
+    auto source_member = member_pointer<MemPtrT>::get(m_member);
+    return (source_object->*source_member)(static_cast<ArgTs>(arguments)...);
+  }
+
   ClassT* m_object;
   MemPtrT m_member;
 };
@@ -78,9 +186,60 @@ struct free_function final : callable_base<ReturnT, ArgTs...>
     : m_function_ptr(pointer)
   {}
 
+  ReturnT call(ArgTs... arguments) const { return (*m_function_ptr)(static_cast<ArgTs>(arguments)...); }
+
   function_pointer_type m_function_ptr;
 };
 
+// what a concrete type holds, for diagnostics: the functor or object type, or the function pointer type. the
+// member called on an object is only known at runtime and is not part of it
+template<typename ConcreteT>
+struct target_type
+{
+  using type = ConcreteT;
+};
+
+template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
+struct target_type<member_function<ClassT, MemPtrT, ReturnT, ArgTs...>>
+{
+  using type = std::remove_cv_t<std::remove_reference_t<ClassT>>;
+};
+
+template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
+struct target_type<member_function_smart_pointer<ClassT, MemPtrT, ReturnT, ArgTs...>>
+{
+  using type = ClassT;
+};
+
+template<typename ClassT, typename MemPtrT, typename ReturnT, typename... ArgTs>
+struct target_type<member_function_raw_pointer<ClassT, MemPtrT, ReturnT, ArgTs...>>
+{
+  using type = ClassT;
+};
+
+template<typename ReturnT, typename... ArgTs>
+struct target_type<free_function<ReturnT, ArgTs...>>
+{
+  using type = ReturnT (*)(ArgTs...);
+};
+
+template<typename ConcreteT>
+using target_type_t = typename target_type<ConcreteT>::type;
+
+template<typename ConcreteT>
+struct target_name
+{
+  static constexpr std::string_view value = type_name<target_type_t<ConcreteT>>();
+};
+
+// the concrete type a functor forwarded as `ClassT` is stored as by a `callable` of `ReturnT(ArgTs...)`, so its
+// size can be checked against a capacity up front. `member` is the call operator it is called through
+template<typename ClassT, typename ReturnT, typename... ArgTs>
+struct stored_functor;
+
+template<typename ClassT, typename ReturnT, typename... ArgTs>
+using stored_functor_t = typename stored_functor<ClassT, ReturnT, ArgTs...>::type;
+
 } // namespace detail
 
 static constexpr auto default_callable_capacity = sizeof(std::uintptr_t) * 4;
@@ -93,6 +252,7 @@ struct callable<ReturnT(ArgTs...), Capacity>
 {
   using function_type = ReturnT(ArgTs...);
   using this_type = callable<ReturnT(ArgTs...), Capacity>;
+  using batch_result_type = batch_result_t<ReturnT>;
 
   // references/moves/copies a constant entity and holds a pointer to non-static member function of
   // the held object
@@ -159,9 +319,24 @@ struct callable<ReturnT(ArgTs...), Capacity>
   // call the stored function, from const source
   ReturnT operator()(ArgTs... arguments) const;
 
+#if defined(__cpp_lib_span)
+  // call the stored function once per argument tuple, in order, from a single type-erased call. by-value arguments
+  // are copied from the rows, rvalue reference and move-only arguments are moved out of them. results are written
+  // to `results` unless it is left empty
+  void invoke_batch(std::span<std::tuple<ArgTs...>> rows, std::span<batch_result_type> results = {}) const;
+
+  // call the stored function once per index of the argument columns (one span per parameter, all the same
+  // length), from a single type-erased call. results are written to `results` unless it is left empty
+  void invoke_batch(std::span<batch_column_t<ArgTs>>... columns, std::span<batch_result_type> results = {}) const;
+#endif
+
   // check if a valid source is stored
   bool empty() const;
 
+  // the address calls are dispatched through, which is the same for every callable holding the same type of target,
+  // or null when empty. `tmf::describe` (from *callable_profile.hpp*) turns it into a readable name
+  const void* dispatch() const noexcept;
+
   ~callable();
 
 private:
@@ -170,14 +345,19 @@ private:
 
   const callable_base<ReturnT, ArgTs...>* access() const;
 
+  // point the type-erased function pointers at the implementations for `ConcreteT`, which must already
+  // be constructed in the storage
+  template<typename ConcreteT>
+  void bind() noexcept;
+
   // check if empty or trivially destructible, if not then call the destructor
   // for the type-erased object
   void destroy();
 
   typename callable_base<ReturnT, ArgTs...>::deleter_function_pointer m_deleter;
   typename callable_base<ReturnT, ArgTs...>::caller_function_pointer m_caller;
-  typename callable_base<ReturnT, ArgTs...>::copier_function_pointer m_copier;
-  typename callable_base<ReturnT, ArgTs...>::mover_function_pointer m_mover;
+  // the same in every language mode, c++17 translation units carry the batch trampoline without calling it
+  const typename callable_base<ReturnT, ArgTs...>::operations* m_operations;
 
   bool m_empty;
 
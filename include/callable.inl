@@ -108,6 +108,77 @@ struct deduction_guide<generic_tag<T>>
 };
 
 } // namespace sfinae
+
+template<typename ClassT, typename ReturnT, typename... ArgTs>
+struct stored_functor
+{
+  using class_type = std::remove_reference_t<ClassT>;
+  using call_operator_ptr_t =
+    decltype(sfinae::generic_member_function<class_type, ReturnT, ArgTs...>::check(&class_type::operator()));
+  using member = std::integral_constant<call_operator_ptr_t, &class_type::operator()>;
+  using type = member_function<ClassT, member, ReturnT, ArgTs...>;
+};
+
+// converts a batch element into the parameter type. lvalue references bind to the element and copyable by-value
+// parameters are copied from it, so rows are left as they were, as columns are. rvalue references and move-only
+// parameters are moved out of the element
+template<typename ArgT, typename ElementT>
+ArgT
+batch_argument(ElementT& element)
+{
+  if constexpr (std::is_lvalue_reference_v<ArgT> || (!std::is_reference_v<ArgT> && std::is_copy_constructible_v<ArgT>)) {
+    return static_cast<ArgT>(element);
+  } else {
+    return static_cast<ArgT>(std::move(element));
+  }
+}
+
+template<typename... ArgTs, typename ConcreteT, typename StoreT, size_t... Indices>
+void
+batch_loop(const ConcreteT& concrete,
+           std::tuple<ArgTs...>* rows,
+           const std::tuple<batch_column_t<ArgTs>*...>* columns,
+           size_t count,
+           StoreT store,
+           std::index_sequence<Indices...>)
+{
+  // the loops live here so the concrete call can be inlined into them
+  if (rows != nullptr) {
+    for (size_t index = 0; index < count; ++index) {
+      auto& row = rows[index];
+      store(index, [&] { return concrete.call(batch_argument<ArgTs>(std::get<Indices>(row))...); });
+    }
+  } else {
+    auto column_pointers = *columns;
+    for (size_t index = 0; index < count; ++index) {
+      store(index, [&] { return concrete.call(batch_argument<ArgTs>(std::get<Indices>(column_pointers)[index])...); });
+    }
+  }
+}
+
+template<typename ReturnT, typename... ArgTs, typename ConcreteT>
+void
+batch_call(const ConcreteT& concrete,
+           std::tuple<ArgTs...>* rows,
+           const std::tuple<batch_column_t<ArgTs>*...>* columns,
+           batch_result_t<ReturnT>* results,
+           size_t count)
+{
+  constexpr bool can_store = std::is_assignable_v<batch_result_t<ReturnT>&, ReturnT>;
+  auto store = [results](size_t index, auto&& call) {
+    if constexpr (std::is_void_v<ReturnT> || !can_store) {
+      call();
+    } else {
+      if (results != nullptr) {
+        results[index] = call();
+      } else {
+        call();
+      }
+    }
+  };
+  batch_loop<ArgTs...>(concrete, rows, columns, count, store, std::index_sequence_for<ArgTs...>{});
+}
+
 } // namespace detail
 
 template<typename u, typename T>
@@ -126,27 +197,7 @@ callable<ReturnT(ArgTs...), Capacity>::callable(ClassT&& object, MemPtrT member)
   using concrete_type = member_function<ClassT, member_function_ptr_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
   new (access()) concrete_type(std::forward<ClassT>(object), member);
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -154,33 +205,11 @@ template<typename ClassT>
 callable<ReturnT(ArgTs...), Capacity>::callable(ClassT&& object) noexcept
   : m_empty(false)
 {
-  using class_type = std::remove_reference_t<ClassT>;
-  using call_operator_ptr_t =
-    decltype(sfinae::generic_member_function<class_type, ReturnT, ArgTs...>::check(&class_type::operator()));
-  using concrete_type = member_function<ClassT, call_operator_ptr_t, ReturnT, ArgTs...>;
+  using stored_type = stored_functor<ClassT, ReturnT, ArgTs...>;
+  using concrete_type = typename stored_type::type;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
-  new (access()) concrete_type(std::forward<ClassT>(object), &class_type::operator());
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  new (access()) concrete_type(std::forward<ClassT>(object), typename stored_type::member{});
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -193,27 +222,7 @@ callable<ReturnT(ArgTs...), Capacity>::callable(ClassT* object, MemPtrT member)
   using concrete_type = member_function_raw_pointer<ClassT, member_function_ptr_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
   new (access()) concrete_type(object, member);
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -224,30 +233,11 @@ callable<ReturnT(ArgTs...), Capacity>::callable(ClassT* object) noexcept
   using class_type = std::remove_pointer_t<ClassT>;
   using call_operator_ptr_t =
     decltype(sfinae::generic_member_function<class_type, ReturnT, ArgTs...>::check(&class_type::operator()));
-  using concrete_type = member_function_raw_pointer<ClassT, call_operator_ptr_t, ReturnT, ArgTs...>;
+  using call_operator_t = std::integral_constant<call_operator_ptr_t, &class_type::operator()>;
+  using concrete_type = member_function_raw_pointer<ClassT, call_operator_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
-  new (access()) concrete_type(object, &class_type::operator());
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  new (access()) concrete_type(object, call_operator_t{});
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -259,27 +249,7 @@ callable<ReturnT(ArgTs...), Capacity>::callable(std::shared_ptr<ClassT>& object,
   using concrete_type = member_function_smart_pointer<ClassT, member_function_ptr_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
   new (access()) concrete_type(object, member);
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -289,30 +259,11 @@ callable<ReturnT(ArgTs...), Capacity>::callable(std::shared_ptr<ClassT>& object)
 {
   using call_operator_ptr_t =
     decltype(sfinae::generic_member_function<ClassT, ReturnT, ArgTs...>::check(&ClassT::operator()));
-  using concrete_type = member_function_smart_pointer<ClassT, call_operator_ptr_t, ReturnT, ArgTs...>;
+  using call_operator_t = std::integral_constant<call_operator_ptr_t, &ClassT::operator()>;
+  using concrete_type = member_function_smart_pointer<ClassT, call_operator_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
-  new (access()) concrete_type(object, &ClassT::operator());
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  new (access()) concrete_type(object, call_operator_t{});
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -324,27 +275,7 @@ callable<ReturnT(ArgTs...), Capacity>::callable(std::shared_ptr<ClassT>&& object
   using concrete_type = member_function_smart_pointer<ClassT, member_function_ptr_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
   new (access()) concrete_type(std::move(object), member);
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -354,30 +285,11 @@ callable<ReturnT(ArgTs...), Capacity>::callable(std::shared_ptr<ClassT>&& object
 {
   using call_operator_ptr_t =
     decltype(sfinae::generic_member_function<ClassT, ReturnT, ArgTs...>::check(&ClassT::operator()));
-  using concrete_type = member_function_smart_pointer<ClassT, call_operator_ptr_t, ReturnT, ArgTs...>;
+  using call_operator_t = std::integral_constant<call_operator_ptr_t, &ClassT::operator()>;
+  using concrete_type = member_function_smart_pointer<ClassT, call_operator_t, ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
-  new (access()) concrete_type(std::move(object), &ClassT::operator());
-  m_deleter = [](auto base) {
-    auto concrete = static_cast<const concrete_type*>(base);
-    concrete->~concrete_type();
-  };
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      auto source_object = concrete->m_object;
-      auto source_member = concrete->m_member;
-      return (source_object.get()->*source_member)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  new (access()) concrete_type(std::move(object), call_operator_t{});
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -387,20 +299,7 @@ callable<ReturnT(ArgTs...), Capacity>::callable(function_type* function_pointer)
   using concrete_type = free_function<ReturnT, ArgTs...>;
   static_assert(sizeof(concrete_type) <= Capacity, CALLABLE_ERROR);
   new (access()) concrete_type(function_pointer);
-  m_deleter = nullptr;
-  m_caller = [](bool is_const, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
-    if (is_const) {
-      auto concrete = static_cast<const concrete_type*>(base);
-      return (*concrete->m_function_ptr)(static_cast<ArgTs>(arguments)...);
-    } else {
-      auto concrete = const_cast<concrete_type*>(static_cast<const concrete_type*>(base));
-      return (*concrete->m_function_ptr)(static_cast<ArgTs>(arguments)...);
-    }
-  };
-  m_copier = [](auto& base, const auto& other_base) {
-    new (&base) concrete_type(static_cast<const concrete_type&>(other_base));
-  };
-  m_mover = [](auto& base, auto&& other_base) { new (&base) concrete_type(static_cast<concrete_type&&>(other_base)); };
+  bind<concrete_type>();
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
@@ -409,36 +308,33 @@ callable<ReturnT(ArgTs...), Capacity>::callable() noexcept
 {
   m_deleter = nullptr;
   m_caller = nullptr;
-  m_copier = nullptr;
-  m_mover = nullptr;
+  m_operations = nullptr;
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
 callable<ReturnT(ArgTs...), Capacity>::callable(const this_type& other) noexcept
+  : m_empty(true)
 {
-  destroy();
   if (other.m_empty) {
   } else {
-    (*other.m_copier)(*access(), *other.access());
+    (*other.m_operations->copier)(*access(), *other.access());
     m_deleter = other.m_deleter;
     m_caller = other.m_caller;
-    m_copier = other.m_copier;
-    m_mover = other.m_mover;
+    m_operations = other.m_operations;
     m_empty = false;
   }
 }
 
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
 callable<ReturnT(ArgTs...), Capacity>::callable(this_type&& other) noexcept
+  : m_empty(true)
 {
-  destroy();
   if (other.m_empty) {
   } else {
-    (*other.m_mover)(*access(), std::move(*other.access()));
+    (*other.m_operations->mover)(*access(), std::move(*other.access()));
     m_deleter = other.m_deleter;
     m_caller = other.m_caller;
-    m_copier = other.m_copier;
-    m_mover = other.m_mover;
+    m_operations = other.m_operations;
     m_empty = false;
     other.destroy();
   }
@@ -452,11 +348,10 @@ callable<ReturnT(ArgTs...), Capacity>::operator=(this_type& rhs) noexcept
   if (rhs.m_empty) {
     return *this;
   } else {
-    (*rhs.m_copier)(*access(), *rhs.access());
+    (*rhs.m_operations->copier)(*access(), *rhs.access());
     m_deleter = rhs.m_deleter;
     m_caller = rhs.m_caller;
-    m_copier = rhs.m_copier;
-    m_mover = rhs.m_mover;
+    m_operations = rhs.m_operations;
     m_empty = false;
     return *this;
   }
@@ -470,11 +365,10 @@ callable<ReturnT(ArgTs...), Capacity>::operator=(const this_type& rhs) noexcept
   if (rhs.m_empty) {
     return *this;
   } else {
-    (*rhs.m_copier)(*access(), *rhs.access());
+    (*rhs.m_operations->copier)(*access(), *rhs.access());
     m_deleter = rhs.m_deleter;
     m_caller = rhs.m_caller;
-    m_copier = rhs.m_copier;
-    m_mover = rhs.m_mover;
+    m_operations = rhs.m_operations;
     m_empty = false;
     return *this;
   }
@@ -488,11 +382,10 @@ callable<ReturnT(ArgTs...), Capacity>::operator=(this_type&& rhs) noexcept
   if (rhs.m_empty) {
     return *this;
   } else {
-    (*rhs.m_mover)(*access(), std::move(*rhs.access()));
+    (*rhs.m_operations->mover)(*access(), std::move(*rhs.access()));
     m_deleter = rhs.m_deleter;
     m_caller = rhs.m_caller;
-    m_copier = rhs.m_copier;
-    m_mover = rhs.m_mover;
+    m_operations = rhs.m_operations;
     m_empty = false;
     rhs.destroy();
     return *this;
@@ -519,6 +412,51 @@ callable<ReturnT(ArgTs...), Capacity>::operator()(ArgTs... arguments) const
   return (*m_caller)(true, access(), static_cast<ArgTs>(arguments)...);
 }
 
+#if defined(__cpp_lib_span)
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+void
+callable<ReturnT(ArgTs...), Capacity>::invoke_batch(std::span<std::tuple<ArgTs...>> rows,
+                                                     std::span<batch_result_type> results) const
+{
+  static_assert(std::is_void_v<ReturnT> || std::is_assignable_v<batch_result_type&, ReturnT>,
+                "results of a batch call must be assignable to `batch_result_type`");
+  if (empty()) {
+    throw callable_exception{ "attempted to call an empty callable." };
+  }
+  if (!results.empty() && results.size() < rows.size()) {
+    throw callable_exception{ "batch results are shorter than the batch arguments." };
+  }
+  (*m_operations->batcher)(access(), rows.data(), nullptr, results.empty() ? nullptr : results.data(), rows.size());
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+void
+callable<ReturnT(ArgTs...), Capacity>::invoke_batch(std::span<batch_column_t<ArgTs>>... columns,
+                                                     std::span<batch_result_type> results) const
+{
+  static_assert(std::is_void_v<ReturnT> || std::is_assignable_v<batch_result_type&, ReturnT>,
+                "results of a batch call must be assignable to `batch_result_type`");
+  if (empty()) {
+    throw callable_exception{ "attempted to call an empty callable." };
+  }
+  size_t count = results.size();
+  if constexpr (sizeof...(ArgTs) > 0) {
+    const size_t sizes[] = { columns.size()... };
+    count = sizes[0];
+    for (auto size : sizes) {
+      if (size != count) {
+        throw callable_exception{ "batch argument columns differ in length." };
+      }
+    }
+    if (!results.empty() && results.size() < count) {
+      throw callable_exception{ "batch results are shorter than the batch arguments." };
+    }
+  }
+  const std::tuple<batch_column_t<ArgTs>*...> column_pointers{ columns.data()... };
+  (*m_operations->batcher)(access(), nullptr, &column_pointers, results.empty() ? nullptr : results.data(), count);
+}
+#endif
+
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
 bool
 callable<ReturnT(ArgTs...), Capacity>::empty() const
@@ -526,6 +464,13 @@ callable<ReturnT(ArgTs...), Capacity>::empty() const
   return m_empty;
 }
 
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+const void*
+callable<ReturnT(ArgTs...), Capacity>::dispatch() const noexcept
+{
+  return m_empty ? nullptr : reinterpret_cast<const void*>(m_caller);
+}
+
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
 callable<ReturnT(ArgTs...), Capacity>::~callable()
 {
@@ -546,6 +491,55 @@ callable<ReturnT(ArgTs...), Capacity>::access() const
   return std::launder(reinterpret_cast<const callable_base<ReturnT, ArgTs...>*>(&m_storage));
 }
 
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+template<typename ConcreteT>
+void
+callable<ReturnT(ArgTs...), Capacity>::bind() noexcept
+{
+  // function pointers have nothing to clean up, and stay valid after being moved from
+  if constexpr (std::is_same_v<ConcreteT, free_function<ReturnT, ArgTs...>>) {
+    m_deleter = nullptr;
+  } else {
+    m_deleter = [](auto base) {
+      auto concrete = static_cast<const ConcreteT*>(base);
+      concrete->~ConcreteT();
+    };
+  }
+  m_caller = [](bool, const callable_base<ReturnT, ArgTs...>* base, ArgTs... arguments) {
+    auto concrete = static_cast<const ConcreteT*>(base);
+#if defined(TMF_CALLABLE_STATS)
+    stats_scope counted{ callable_stats::of<ConcreteT>(target_name<ConcreteT>::value) };
+#endif
+#if defined(TMF_CALLABLE_TRACE)
+    trace_scope traced{ trace_tag<target_type_t<ConcreteT>>::value };
+#endif
+#if defined(TMF_CALLABLE_PROFILE)
+    if (callable_profile::sampled()) {
+      callable_profile::of<ConcreteT>(target_name<ConcreteT>::value).samples.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+    return concrete->call(static_cast<ArgTs>(arguments)...);
+  };
+#if defined(TMF_CALLABLE_PROFILE)
+  callable_profile::of<ConcreteT>(target_name<ConcreteT>::value).bind(reinterpret_cast<const void*>(m_caller));
+#endif
+#if defined(TMF_CALLABLE_SIZES)
+  callable_sizes::of<this_type>(type_name<this_type>(), Capacity).record(sizeof(ConcreteT), alignof(ConcreteT));
+#endif
+  static constexpr typename callable_base<ReturnT, ArgTs...>::operations table{
+    [](auto& base, const auto& other_base) { new (&base) ConcreteT(static_cast<const ConcreteT&>(other_base)); },
+    [](auto& base, auto&& other_base) { new (&base) ConcreteT(static_cast<ConcreteT&&>(other_base)); },
+    [](auto base, auto rows, auto columns, auto results, auto count) {
+#if defined(TMF_CALLABLE_STATS)
+      // batches are counted but not timed, a batch is not one call
+      callable_stats::of<ConcreteT>(target_name<ConcreteT>::value).calls.fetch_add(count, std::memory_order_relaxed);
+#endif
+      batch_call<ReturnT, ArgTs...>(*static_cast<const ConcreteT*>(base), rows, columns, results, count);
+    }
+  };
+  m_operations = &table;
+}
+
 template<typename ReturnT, typename... ArgTs, size_t Capacity>
 void
 callable<ReturnT(ArgTs...), Capacity>::destroy()
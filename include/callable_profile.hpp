@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "registry.hpp"
+
+namespace tmf {
+
+// names the target types behind dispatch pointers, and samples which of them are called the most. while
+// `TMF_CALLABLE_PROFILE` is defined every `callable` registers the dispatch pointer of its target type on
+// construction, and while `sampling` is given a period it counts every period-th call of each thread against the
+// called type
+struct callable_profile : registry<callable_profile, std::string_view>
+{
+  // one line of the report
+  struct hot_target
+  {
+    std::string_view name;
+    std::uint64_t samples;
+  };
+
+  static constexpr std::size_t dispatches = 8;
+
+  explicit callable_profile(std::string_view target) noexcept;
+
+  // sample one call in `period` from now on, zero stops sampling
+  static void sampling(std::uint32_t period) noexcept;
+
+  static std::uint32_t sampling() noexcept;
+
+  // count down the calling thread's period, true for the call that should be sampled
+  static bool sampled() noexcept;
+
+  // the `count` most sampled types, most sampled first
+  static std::vector<hot_target> top(std::size_t count);
+
+  // `top` as a table of samples, share of all samples and name, one type per line
+  static std::string report(std::size_t count);
+
+  // a readable name for a dispatch pointer, which is the name of its target type when it was registered. other
+  // addresses are looked up with `dladdr` and demangled where the platform has it, which only finds symbols in
+  // the dynamic symbol table (link with `-rdynamic`), and fall back to the module and offset of the address
+  static std::string symbolize(const void* dispatch);
+
+  // remember `address` as a dispatch pointer of this type. callables of different capacities holding the same
+  // type of target dispatch through different addresses, the first `dispatches` of them are remembered
+  void bind(const void* address) noexcept;
+
+  // zero the samples of this type
+  void clear() noexcept;
+
+  std::string_view name;
+  std::atomic<const void*> dispatch[dispatches] = {};
+  std::atomic<std::uint64_t> samples{ 0 };
+
+private:
+  static std::atomic<std::uint32_t>& period() noexcept;
+};
+
+// the readable name of whatever `target` (a `callable`) dispatches to
+template<typename CallableT>
+std::string
+describe(const CallableT& target);
+
+inline namespace detail {
+
+// the template argument of the `bind<...>` a demangled trampoline symbol was instantiated from, or the whole
+// symbol when it is something else
+std::string_view bound_target(std::string_view symbol) noexcept;
+}
+}
+
+#include "callable_profile.inl"
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define TMF_CALLABLE_PROFILE_DLADDR
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define TMF_CALLABLE_PROFILE_DEMANGLE
+#endif
+
+namespace tmf {
+
+inline callable_profile::callable_profile(std::string_view target) noexcept
+  : name(target)
+{
+}
+
+inline void
+callable_profile::sampling(std::uint32_t every) noexcept
+{
+  period().store(every, std::memory_order_relaxed);
+}
+
+inline std::uint32_t
+callable_profile::sampling() noexcept
+{
+  return period().load(std::memory_order_relaxed);
+}
+
+inline bool
+callable_profile::sampled() noexcept
+{
+  thread_local std::uint32_t countdown = 0;
+  auto every = sampling();
+  if (every == 0) {
+    return false;
+  }
+  // restart the count when the period was shortened since the last call
+  if (countdown == 0 || countdown > every) {
+    countdown = every;
+  }
+  return --countdown == 0;
+}
+
+inline std::vector<callable_profile::hot_target>
+callable_profile::top(std::size_t count)
+{
+  std::vector<hot_target> targets;
+  for (auto profile = first(); profile != nullptr; profile = profile->next) {
+    auto sampled = profile->samples.load(std::memory_order_relaxed);
+    if (sampled != 0) {
+      targets.push_back({ profile->name, sampled });
+    }
+  }
+  std::sort(targets.begin(), targets.end(), [](const hot_target& left, const hot_target& right) {
+    return left.samples != right.samples ? left.samples > right.samples : left.name < right.name;
+  });
+  if (targets.size() > count) {
+    targets.resize(count);
+  }
+  return targets;
+}
+
+inline std::string
+callable_profile::report(std::size_t count)
+{
+  std::uint64_t total = 0;
+  for (auto profile = first(); profile != nullptr; profile = profile->next) {
+    total += profile->samples.load(std::memory_order_relaxed);
+  }
+  std::string table;
+  char line[64];
+  for (const auto& target : top(count)) {
+    std::snprintf(line,
+                  sizeof(line),
+                  "%12llu %6.2f%%  ",
+                  static_cast<unsigned long long>(target.samples),
+                  100.0 * static_cast<double>(target.samples) / static_cast<double>(total));
+    table += line;
+    table += target.name;
+    table += '\n';
+  }
+  return table;
+}
+
+inline std::string
+callable_profile::symbolize(const void* address)
+{
+  if (address == nullptr) {
+    return "empty";
+  }
+  for (auto profile = first(); profile != nullptr; profile = profile->next) {
+    for (auto& dispatch : profile->dispatch) {
+      if (dispatch.load(std::memory_order_relaxed) == address) {
+        return std::string{ profile->name };
+      }
+    }
+  }
+  char fallback[64];
+#if defined(TMF_CALLABLE_PROFILE_DLADDR)
+  Dl_info info{};
+  if (::dladdr(address, &info) != 0) {
+    if (info.dli_sname != nullptr) {
+#if defined(TMF_CALLABLE_PROFILE_DEMANGLE)
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      if (status == 0 && demangled != nullptr) {
+        std::string symbol{ bound_target(demangled) };
+        std::free(demangled);
+        return symbol;
+      }
+      std::free(demangled);
+#endif
+      return info.dli_sname;
+    }
+    if (info.dli_fname != nullptr) {
+      std::snprintf(fallback,
+                    sizeof(fallback),
+                    "+0x%llx",
+                    static_cast<unsigned long long>(static_cast<const char*>(address) -
+                                                    static_cast<const char*>(info.dli_fbase)));
+      return info.dli_fname + std::string{ fallback };
+    }
+  }
+#endif
+  std::snprintf(fallback, sizeof(fallback), "%p", address);
+  return fallback;
+}
+
+inline void
+callable_profile::bind(const void* address) noexcept
+{
+  // every callable of the same capacity binds the same address, only the first one needs to write it
+  for (auto& slot : dispatch) {
+    auto known = slot.load(std::memory_order_relaxed);
+    if (known == address) {
+      return;
+    }
+    // another thread may take the empty slot first, for this address or for another one
+    if (known == nullptr &&
+        (slot.compare_exchange_strong(known, address, std::memory_order_relaxed) || known == address)) {
+      return;
+    }
+  }
+}
+
+inline void
+callable_profile::clear() noexcept
+{
+  samples.store(0, std::memory_order_relaxed);
+}
+
+inline std::atomic<std::uint32_t>&
+callable_profile::period() noexcept
+{
+  static std::atomic<std::uint32_t> every{ 0 };
+  return every;
+}
+
+template<typename CallableT>
+std::string
+describe(const CallableT& target)
+{
+  return callable_profile::symbolize(target.dispatch());
+}
+
+inline namespace detail {
+
+inline std::string_view
+bound_target(std::string_view symbol) noexcept
+{
+  constexpr std::string_view marker = "::bind<";
+  auto start = symbol.find(marker);
+  if (start == std::string_view::npos) {
+    return symbol;
+  }
+  start += marker.size();
+  std::size_t depth = 1;
+  for (auto position = start; position < symbol.size(); ++position) {
+    if (symbol[position] == '<') {
+      ++depth;
+    } else if (symbol[position] == '>' && --depth == 0) {
+      auto end = position;
+      while (end > start && symbol[end - 1] == ' ') {
+        --end;
+      }
+      return symbol.substr(start, end - start);
+    }
+  }
+  return symbol;
+}
+}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "registry.hpp"
+
+namespace tmf {
+
+// the sizes of the targets one `callable` type was constructed from, measured against its capacity. while
+// `TMF_CALLABLE_SIZES` is defined every `callable` records each target it is constructed from, copies and moves of
+// a callable are not counted again. sizes are counted in a histogram with one bucket per
+// `alignof(std::max_align_t)` bytes, the granularity storage actually grows in
+struct callable_sizes : registry<callable_sizes, std::string_view, std::size_t>
+{
+  static constexpr std::size_t granularity = alignof(std::max_align_t);
+
+  // the last bucket counts every target larger than the ones before it can
+  static constexpr std::size_t buckets = 64;
+
+  callable_sizes(std::string_view callable, std::size_t capacity) noexcept;
+
+  // one line per constructed callable type with the capacity that fits `percentile` percent of its targets, and
+  // the one that fits all of them
+  static std::string report(double percentile = 99.0);
+
+  // zero this callable type
+  void clear() noexcept;
+
+  void record(std::size_t size, std::size_t alignment) noexcept;
+
+  // the smallest capacity, in steps of `granularity`, that holds at least `percentile` percent of the recorded
+  // targets. zero when nothing was recorded
+  std::size_t recommend(double percentile) const noexcept;
+
+  std::string_view name;
+  std::size_t capacity;
+  std::atomic<std::uint64_t> constructions{ 0 };
+  std::atomic<std::uint64_t> wasted_bytes{ 0 };
+  std::atomic<std::size_t> largest{ 0 };
+  std::atomic<std::size_t> alignment{ 0 };
+  std::atomic<std::uint64_t> histogram[buckets] = {};
+};
+}
+
+#include "callable_sizes.inl"
\ No newline at end of file
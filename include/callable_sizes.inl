@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+namespace tmf {
+
+inline callable_sizes::callable_sizes(std::string_view callable, std::size_t storage) noexcept
+  : name(callable)
+  , capacity(storage)
+{
+}
+
+inline std::string
+callable_sizes::report(double percentile)
+{
+  std::string table;
+  char line[256];
+  for (auto sizes = first(); sizes != nullptr; sizes = sizes->next) {
+    auto constructed = sizes->constructions.load(std::memory_order_relaxed);
+    if (constructed == 0) {
+      continue;
+    }
+    table += sizes->name;
+    std::snprintf(line,
+                  sizeof(line),
+                  ": %llu constructions, capacity %zu, largest %zu, alignment %zu, %.1f bytes wasted on average, "
+                  "p%g fits in %zu, all fit in %zu\n",
+                  static_cast<unsigned long long>(constructed),
+                  sizes->capacity,
+                  sizes->largest.load(std::memory_order_relaxed),
+                  sizes->alignment.load(std::memory_order_relaxed),
+                  static_cast<double>(sizes->wasted_bytes.load(std::memory_order_relaxed)) /
+                    static_cast<double>(constructed),
+                  percentile,
+                  sizes->recommend(percentile),
+                  sizes->recommend(100.0));
+    table += line;
+  }
+  return table;
+}
+
+inline void
+callable_sizes::clear() noexcept
+{
+  constructions.store(0, std::memory_order_relaxed);
+  wasted_bytes.store(0, std::memory_order_relaxed);
+  largest.store(0, std::memory_order_relaxed);
+  alignment.store(0, std::memory_order_relaxed);
+  for (auto& count : histogram) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline void
+callable_sizes::record(std::size_t size, std::size_t align) noexcept
+{
+  constructions.fetch_add(1, std::memory_order_relaxed);
+  wasted_bytes.fetch_add(capacity - size, std::memory_order_relaxed);
+  auto index = (size + granularity - 1) / granularity;
+  histogram[index < buckets ? index : buckets - 1].fetch_add(1, std::memory_order_relaxed);
+  auto seen = largest.load(std::memory_order_relaxed);
+  while (seen < size && !largest.compare_exchange_weak(seen, size, std::memory_order_relaxed)) {
+  }
+  seen = alignment.load(std::memory_order_relaxed);
+  while (seen < align && !alignment.compare_exchange_weak(seen, align, std::memory_order_relaxed)) {
+  }
+}
+
+inline std::size_t
+callable_sizes::recommend(double percentile) const noexcept
+{
+  auto constructed = constructions.load(std::memory_order_relaxed);
+  if (constructed == 0) {
+    return 0;
+  }
+  auto needed = static_cast<std::uint64_t>(std::ceil(static_cast<double>(constructed) * percentile / 100.0));
+  auto biggest = (largest.load(std::memory_order_relaxed) + granularity - 1) / granularity * granularity;
+  std::uint64_t covered = 0;
+  for (std::size_t index = 0; index + 1 < buckets; ++index) {
+    covered += histogram[index].load(std::memory_order_relaxed);
+    if (covered >= needed) {
+      return index * granularity < biggest ? index * granularity : biggest;
+    }
+  }
+  return biggest;
+}
+}
\ No newline at end of file
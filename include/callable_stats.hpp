@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "registry.hpp"
+
+namespace tmf {
+
+// invocation statistics of one target type, collected while `TMF_CALLABLE_STATS` is defined. calls are always
+// counted, and while `timing` is switched on they are also timed into a histogram with one bucket per power of two
+// nanoseconds. every type registers itself on its first call
+struct callable_stats : registry<callable_stats, std::string_view>
+{
+  static constexpr std::size_t buckets = 48;
+
+  explicit callable_stats(std::string_view target) noexcept;
+
+  // time calls from now on, or stop
+  static void timing(bool enabled) noexcept;
+
+  static bool timing() noexcept;
+
+  // every registered type with at least one call, as a JSON document
+  static std::string json();
+
+  // zero this type
+  void clear() noexcept;
+
+  void record(std::uint64_t nanoseconds) noexcept;
+
+  // bucket `index` counts calls that took below 2^index nanoseconds, and at least half that
+  static std::size_t bucket(std::uint64_t nanoseconds) noexcept;
+
+  std::string_view name;
+  std::atomic<std::uint64_t> calls{ 0 };
+  std::atomic<std::uint64_t> timed_calls{ 0 };
+  std::atomic<std::uint64_t> timed_nanoseconds{ 0 };
+  std::atomic<std::uint64_t> histogram[buckets] = {};
+
+private:
+  static std::atomic<bool>& timing_switch() noexcept;
+};
+
+inline namespace detail {
+
+// counts the call it lives through, and times it while timing is switched on
+class stats_scope
+{
+public:
+  explicit stats_scope(callable_stats& stats) noexcept;
+
+  stats_scope(const stats_scope&) = delete;
+
+  stats_scope& operator=(const stats_scope&) = delete;
+
+  ~stats_scope();
+
+private:
+  callable_stats& m_stats;
+  std::int64_t m_start;
+};
+}
+}
+
+#include "callable_stats.inl"
\ No newline at end of file
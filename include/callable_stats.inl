@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace tmf {
+
+inline callable_stats::callable_stats(std::string_view target) noexcept
+  : name(target)
+{
+}
+
+inline void
+callable_stats::timing(bool enabled) noexcept
+{
+  timing_switch().store(enabled, std::memory_order_relaxed);
+}
+
+inline bool
+callable_stats::timing() noexcept
+{
+  return timing_switch().load(std::memory_order_relaxed);
+}
+
+inline std::string
+callable_stats::json()
+{
+  std::string document = "{\n  \"targets\": [";
+  bool separate = false;
+  char number[32];
+  auto append = [&document, &number](std::uint64_t value) {
+    std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+    document += number;
+  };
+  for (auto stats = first(); stats != nullptr; stats = stats->next) {
+    auto calls = stats->calls.load(std::memory_order_relaxed);
+    if (calls == 0) {
+      continue;
+    }
+    document += separate ? ",\n    { \"name\": \"" : "\n    { \"name\": \"";
+    separate = true;
+    for (char character : stats->name) {
+      if (character == '"' || character == '\\') {
+        document += '\\';
+      }
+      document += character;
+    }
+    document += "\", \"calls\": ";
+    append(calls);
+    document += ", \"timed_calls\": ";
+    append(stats->timed_calls.load(std::memory_order_relaxed));
+    document += ", \"timed_nanoseconds\": ";
+    append(stats->timed_nanoseconds.load(std::memory_order_relaxed));
+    // only the buckets that counted anything, as [below nanoseconds, calls]
+    document += ", \"histogram\": [";
+    bool separate_bucket = false;
+    for (std::size_t index = 0; index < buckets; ++index) {
+      auto count = stats->histogram[index].load(std::memory_order_relaxed);
+      if (count == 0) {
+        continue;
+      }
+      document += separate_bucket ? ", [" : "[";
+      separate_bucket = true;
+      append(std::uint64_t{ 1 } << index);
+      document += ", ";
+      append(count);
+      document += "]";
+    }
+    document += "] }";
+  }
+  document += "\n  ]\n}\n";
+  return document;
+}
+
+inline void
+callable_stats::clear() noexcept
+{
+  calls.store(0, std::memory_order_relaxed);
+  timed_calls.store(0, std::memory_order_relaxed);
+  timed_nanoseconds.store(0, std::memory_order_relaxed);
+  for (auto& count : histogram) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline void
+callable_stats::record(std::uint64_t nanoseconds) noexcept
+{
+  timed_calls.fetch_add(1, std::memory_order_relaxed);
+  timed_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+  histogram[bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline std::size_t
+callable_stats::bucket(std::uint64_t nanoseconds) noexcept
+{
+  std::size_t width = 0;
+  for (; nanoseconds != 0 && width + 1 < buckets; nanoseconds >>= 1) {
+    ++width;
+  }
+  return width;
+}
+
+inline std::atomic<bool>&
+callable_stats::timing_switch() noexcept
+{
+  static std::atomic<bool> enabled{ false };
+  return enabled;
+}
+
+inline stats_scope::stats_scope(callable_stats& stats) noexcept
+  : m_stats(stats)
+  , m_start(-1)
+{
+  m_stats.calls.fetch_add(1, std::memory_order_relaxed);
+  if (callable_stats::timing()) {
+    m_start = std::chrono::steady_clock::now().time_since_epoch().count();
+  }
+}
+
+inline stats_scope::~stats_scope()
+{
+  if (m_start != -1) {
+    auto elapsed = std::chrono::steady_clock::now().time_since_epoch().count() - m_start;
+    m_stats.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                std::chrono::steady_clock::duration{ elapsed })
+                                                .count()));
+  }
+}
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "type_name.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if !defined(TMF_CALLABLE_TRACE_EVENTS)
+#define TMF_CALLABLE_TRACE_EVENTS 16384
+#endif
+
+namespace tmf {
+
+// the name trace events of calls to targets of type `TargetT` carry, specialize it to tag a type
+template<typename TargetT>
+struct trace_tag
+{
+  static constexpr std::string_view value = type_name<TargetT>();
+};
+
+// a timeline of calls in the Chrome trace event format, which Perfetto reads as well. while `TMF_CALLABLE_TRACE` is
+// defined every `callable` records a begin and an end event per call whenever tracing is enabled. each thread
+// records into a buffer of its own of `TMF_CALLABLE_TRACE_EVENTS` events, which `json` drains. events that find
+// their buffer full are dropped. a thread hands its buffer back when it exits, and a thread that starts tracing
+// later takes it over once it was drained, so there are as many buffers as threads ever traced at the same time
+struct callable_trace
+{
+  static constexpr std::size_t events_per_thread = TMF_CALLABLE_TRACE_EVENTS;
+
+  static void enable(bool enabled) noexcept;
+
+  static bool enabled() noexcept;
+
+  // record events on the calling thread, `name` must outlive the next drain. `begin` returns whether the event was
+  // stored, its `end` is only recorded if it was, so that a dropped begin leaves no unmatched end behind
+  static bool begin(std::string_view name) noexcept;
+
+  static void end(std::string_view name) noexcept;
+
+  // drain every buffered event into a Chrome trace document
+  static std::string json();
+
+  // drain every buffered event into a Chrome trace file, returns false if it cannot be written
+  static bool write(const char* path);
+
+  // events dropped so far because their buffer was full
+  static std::uint64_t dropped() noexcept;
+
+  // buffers allocated so far
+  static std::size_t buffer_count() noexcept;
+
+private:
+  struct event
+  {
+    std::string_view name;
+    std::uint64_t nanoseconds;
+    bool begin;
+  };
+
+  // a single producer single consumer ring: its thread records, `json` drains under a lock
+  struct buffer
+  {
+    alignas(64) std::atomic<std::uint64_t> head{ 0 };
+    alignas(64) std::atomic<std::uint64_t> tail{ 0 };
+    std::uint64_t thread = 0;
+    // set once its thread exited, until another thread takes it over
+    std::atomic<bool> retired{ false };
+    buffer* next = nullptr;
+    event events[events_per_thread];
+  };
+
+  // false when the event was dropped
+  static bool record(std::string_view name, bool begin) noexcept;
+
+  static buffer* local() noexcept;
+
+  // a drained buffer of a thread that exited, or a new one
+  static buffer* acquire() noexcept;
+
+  static std::atomic<bool>& switch_state() noexcept;
+
+  static std::atomic<buffer*>& buffers() noexcept;
+
+  static std::atomic<std::uint64_t>& dropped_events() noexcept;
+};
+
+inline namespace detail {
+
+// records the call it lives through, if tracing is enabled when it starts
+class trace_scope
+{
+public:
+  explicit trace_scope(std::string_view name) noexcept;
+
+  trace_scope(const trace_scope&) = delete;
+
+  trace_scope& operator=(const trace_scope&) = delete;
+
+  ~trace_scope();
+
+private:
+  std::string_view m_name;
+  bool m_recorded;
+};
+}
+}
+
+#include "callable_trace.inl"
\ No newline at end of file
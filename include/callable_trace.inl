@@ -0,0 +1,215 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tmf {
+
+inline void
+callable_trace::enable(bool enabled) noexcept
+{
+  switch_state().store(enabled, std::memory_order_relaxed);
+}
+
+inline bool
+callable_trace::enabled() noexcept
+{
+  return switch_state().load(std::memory_order_relaxed);
+}
+
+inline bool
+callable_trace::begin(std::string_view name) noexcept
+{
+  if (!enabled()) {
+    return false;
+  }
+  return record(name, true);
+}
+
+inline void
+callable_trace::end(std::string_view name) noexcept
+{
+  record(name, false);
+}
+
+inline std::string
+callable_trace::json()
+{
+  static std::mutex draining;
+  std::lock_guard<std::mutex> lock{ draining };
+  std::string document = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool separate = false;
+  char number[64];
+  for (auto thread = buffers().load(std::memory_order_acquire); thread != nullptr; thread = thread->next) {
+    auto tail = thread->tail.load(std::memory_order_relaxed);
+    auto head = thread->head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      auto& recorded = thread->events[tail % events_per_thread];
+      document += separate ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+      separate = true;
+      for (char character : recorded.name) {
+        if (character == '"' || character == '\\') {
+          document += '\\';
+        }
+        document += character;
+      }
+      // timestamps are in microseconds
+      std::snprintf(number,
+                    sizeof(number),
+                    "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%llu}",
+                    recorded.begin ? 'B' : 'E',
+                    static_cast<double>(recorded.nanoseconds) / 1e3,
+                    static_cast<unsigned long long>(thread->thread));
+      document += number;
+    }
+    // hand the drained events back to the recording thread
+    thread->tail.store(tail, std::memory_order_release);
+  }
+  document += "\n]}\n";
+  return document;
+}
+
+inline bool
+callable_trace::write(const char* path)
+{
+  auto document = json();
+  auto file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+  auto written = std::fwrite(document.data(), 1, document.size(), file) == document.size();
+  return std::fclose(file) == 0 && written;
+}
+
+inline std::uint64_t
+callable_trace::dropped() noexcept
+{
+  return dropped_events().load(std::memory_order_relaxed);
+}
+
+inline std::size_t
+callable_trace::buffer_count() noexcept
+{
+  std::size_t count = 0;
+  for (auto thread = buffers().load(std::memory_order_acquire); thread != nullptr; thread = thread->next) {
+    ++count;
+  }
+  return count;
+}
+
+inline bool
+callable_trace::record(std::string_view name, bool begin) noexcept
+{
+  auto own = local();
+  if (own == nullptr) {
+    dropped_events().fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto head = own->head.load(std::memory_order_relaxed);
+  if (head - own->tail.load(std::memory_order_acquire) == events_per_thread) {
+    dropped_events().fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  own->events[head % events_per_thread] = event{
+    name, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), begin
+  };
+  own->head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+inline callable_trace::buffer*
+callable_trace::local() noexcept
+{
+  // buffers outlive their threads, so that events recorded just before a thread exits can still be drained. the
+  // thread only gives up its claim on the way out
+  struct owner
+  {
+    ~owner()
+    {
+      if (own != nullptr) {
+        own->retired.store(true, std::memory_order_release);
+        own = nullptr;
+      }
+    }
+
+    buffer* own;
+  };
+  thread_local owner current{ acquire() };
+  return current.own;
+}
+
+inline callable_trace::buffer*
+callable_trace::acquire() noexcept
+{
+  auto taken = buffers().load(std::memory_order_acquire);
+  for (; taken != nullptr; taken = taken->next) {
+    // nothing records into a retired buffer, so once drained it stays drained
+    bool retired = taken->retired.load(std::memory_order_acquire);
+    if (retired && taken->tail.load(std::memory_order_acquire) == taken->head.load(std::memory_order_relaxed) &&
+        taken->retired.compare_exchange_strong(retired, false, std::memory_order_acquire, std::memory_order_relaxed)) {
+      break;
+    }
+  }
+  auto created = taken == nullptr;
+  if (created) {
+    taken = new (std::nothrow) buffer;
+    if (taken == nullptr) {
+      return taken;
+    }
+  }
+#if defined(__linux__)
+  taken->thread = static_cast<std::uint64_t>(::syscall(SYS_gettid));
+#else
+  static std::atomic<std::uint64_t> threads{ 0 };
+  taken->thread = threads.fetch_add(1, std::memory_order_relaxed) + 1;
+#endif
+  if (created) {
+    auto head = buffers().load(std::memory_order_relaxed);
+    do {
+      taken->next = head;
+    } while (!buffers().compare_exchange_weak(head, taken, std::memory_order_release, std::memory_order_relaxed));
+  }
+  return taken;
+}
+
+inline std::atomic<bool>&
+callable_trace::switch_state() noexcept
+{
+  static std::atomic<bool> enabled{ false };
+  return enabled;
+}
+
+inline std::atomic<callable_trace::buffer*>&
+callable_trace::buffers() noexcept
+{
+  static std::atomic<buffer*> head{ nullptr };
+  return head;
+}
+
+inline std::atomic<std::uint64_t>&
+callable_trace::dropped_events() noexcept
+{
+  static std::atomic<std::uint64_t> dropped{ 0 };
+  return dropped;
+}
+
+inline trace_scope::trace_scope(std::string_view name) noexcept
+  : m_name(name)
+  , m_recorded(callable_trace::begin(name))
+{}
+
+inline trace_scope::~trace_scope()
+{
+  if (m_recorded) {
+    callable_trace::end(m_name);
+  }
+}
+}
\ No newline at end of file
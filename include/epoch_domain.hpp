@@ -0,0 +1,78 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace tmf {
+
+// epoch based reclamation: readers announce themselves with a wait-free `enter`, writers `retire` whatever readers
+// might still be looking at, and the retired work runs once every reader that could have seen it has left.
+// `retire`, `collect` and `synchronize` must be serialized by the owner, `enter` is safe from any thread
+class epoch_domain
+{
+public:
+  // marks the calling thread as a reader until destroyed
+  class guard
+  {
+  public:
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+    ~guard();
+
+  private:
+    friend class epoch_domain;
+
+    explicit guard(std::atomic<size_t>* readers) noexcept;
+
+    std::atomic<size_t>* m_readers;
+  };
+
+  epoch_domain() noexcept;
+
+  epoch_domain(const epoch_domain&) = delete;
+
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+  // runs everything still retired, there must be no readers left
+  ~epoch_domain();
+
+  // start reading, costs one atomic increment
+  guard enter() const noexcept;
+
+  // defer `reclaim` until every reader that entered before this call has left
+  void retire(callable<void()> reclaim);
+
+  // run the retired work whose readers have left, without waiting for any others
+  void collect();
+
+  // wait until everything retired so far has run
+  void synchronize();
+
+  // retired work that has not run yet
+  size_t pending() const;
+
+private:
+  // move to the next epoch if no reader is left in the epoch before the current one
+  bool try_advance();
+
+  static size_t shard_index() noexcept;
+
+  static constexpr size_t shard_count = 8;
+
+  // reader counts for both epoch parities, spread over cache lines to keep readers on different threads apart
+  struct alignas(64) shard
+  {
+    std::atomic<size_t> readers[2];
+  };
+
+  std::atomic<std::uint64_t> m_epoch;
+  mutable shard m_shards[shard_count];
+  std::vector<std::pair<std::uint64_t, callable<void()>>> m_retired;
+};
+}
+
+#include "epoch_domain.inl"
\ No newline at end of file
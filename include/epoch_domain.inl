@@ -0,0 +1,109 @@
+#pragma once
+
+#include <thread>
+
+namespace tmf {
+
+inline epoch_domain::guard::guard(std::atomic<size_t>* readers) noexcept
+  : m_readers(readers)
+{}
+
+inline epoch_domain::guard::~guard()
+{
+  m_readers->fetch_sub(1, std::memory_order_release);
+}
+
+inline epoch_domain::epoch_domain() noexcept
+  : m_epoch(0)
+{
+  for (auto& shard : m_shards) {
+    shard.readers[0].store(0, std::memory_order_relaxed);
+    shard.readers[1].store(0, std::memory_order_relaxed);
+  }
+}
+
+inline epoch_domain::~epoch_domain()
+{
+  for (auto& retired : m_retired) {
+    retired.second();
+  }
+}
+
+inline epoch_domain::guard
+epoch_domain::enter() const noexcept
+{
+  // a reader that loads a stale epoch still counts in a parity the writer checks before reclaiming anything it
+  // could have seen, because it only reads shared data after the increment
+  auto epoch = m_epoch.load(std::memory_order_seq_cst);
+  auto readers = &m_shards[shard_index()].readers[epoch & 1];
+  readers->fetch_add(1, std::memory_order_seq_cst);
+  return guard{ readers };
+}
+
+inline void
+epoch_domain::retire(callable<void()> reclaim)
+{
+  m_retired.emplace_back(m_epoch.load(std::memory_order_seq_cst), std::move(reclaim));
+}
+
+inline void
+epoch_domain::collect()
+{
+  if (m_retired.empty()) {
+    return;
+  }
+  // work retired in epoch `e` is safe once the epoch reaches `e + 2`, both parities have been empty since
+  if (try_advance()) {
+    try_advance();
+  }
+  auto epoch = m_epoch.load(std::memory_order_seq_cst);
+  size_t kept = 0;
+  for (size_t index = 0; index < m_retired.size(); ++index) {
+    if (m_retired[index].first + 2 <= epoch) {
+      m_retired[index].second();
+    } else {
+      if (kept != index) {
+        m_retired[kept] = std::move(m_retired[index]);
+      }
+      ++kept;
+    }
+  }
+  m_retired.resize(kept);
+}
+
+inline void
+epoch_domain::synchronize()
+{
+  for (collect(); !m_retired.empty(); collect()) {
+    std::this_thread::yield();
+  }
+}
+
+inline size_t
+epoch_domain::pending() const
+{
+  return m_retired.size();
+}
+
+inline bool
+epoch_domain::try_advance()
+{
+  auto epoch = m_epoch.load(std::memory_order_seq_cst);
+  auto previous_parity = (epoch + 1) & 1;
+  for (auto& shard : m_shards) {
+    if (shard.readers[previous_parity].load(std::memory_order_seq_cst) != 0) {
+      return false;
+    }
+  }
+  m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+  return true;
+}
+
+inline size_t
+epoch_domain::shard_index() noexcept
+{
+  static std::atomic<size_t> next_index{ 0 };
+  thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % shard_count;
+  return index;
+}
+}
\ No newline at end of file
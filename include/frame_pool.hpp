@@ -0,0 +1,76 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <mutex>
+
+namespace tmf {
+
+// recycles coroutine frames by size class, so that starting and finishing coroutines stays off the global allocator
+// once the pool is warm. every thread keeps its own free lists and trades frames with a shared list in batches.
+// memory given to the pool is kept until the process exits, frames bigger than the largest class come from
+// `operator new` directly
+class frame_pool
+{
+public:
+  static constexpr size_t smallest_frame = 64;
+  static constexpr size_t size_classes = 6;
+  static constexpr size_t largest_frame = smallest_frame << (size_classes - 1);
+  // frames moved between a thread and the shared list at once
+  static constexpr size_t batch = 32;
+
+  static void* allocate(size_t bytes);
+
+  // `bytes` must be the size the frame was allocated with
+  static void deallocate(void* frame, size_t bytes) noexcept;
+
+  // frames of the class fitting `bytes` that the calling thread can hand out without taking the shared lock
+  static size_t cached(size_t bytes) noexcept;
+
+private:
+  struct free_frame
+  {
+    free_frame* next;
+  };
+
+  struct free_list
+  {
+    free_frame* head = nullptr;
+    size_t count = 0;
+
+    void push(free_frame* frame) noexcept;
+
+    free_frame* pop() noexcept;
+  };
+
+  struct shared_lists
+  {
+    std::mutex mutex;
+    free_list lists[size_classes];
+  };
+
+  // gives every cached frame to the shared lists when its thread exits
+  struct thread_cache
+  {
+    free_list lists[size_classes];
+
+    ~thread_cache();
+  };
+
+  // `size_classes` when the frame is too big for any class
+  static size_t size_class(size_t bytes) noexcept;
+
+  static size_t class_bytes(size_t index) noexcept;
+
+  static shared_lists& shared() noexcept;
+
+  static thread_cache& local() noexcept;
+
+  // take a batch from the shared list, or carve a new one
+  static void refill(free_list& list, size_t index);
+
+  static void spill(free_list& list, size_t index, size_t count) noexcept;
+};
+}
+
+#include "frame_pool.inl"
\ No newline at end of file
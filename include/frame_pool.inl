@@ -0,0 +1,128 @@
+#pragma once
+
+#include <new>
+
+namespace tmf {
+
+inline void
+frame_pool::free_list::push(free_frame* frame) noexcept
+{
+  frame->next = head;
+  head = frame;
+  ++count;
+}
+
+inline frame_pool::free_frame*
+frame_pool::free_list::pop() noexcept
+{
+  auto frame = head;
+  head = frame->next;
+  --count;
+  return frame;
+}
+
+inline frame_pool::thread_cache::~thread_cache()
+{
+  for (size_t index = 0; index < size_classes; ++index) {
+    spill(lists[index], index, lists[index].count);
+  }
+}
+
+inline void*
+frame_pool::allocate(size_t bytes)
+{
+  auto index = size_class(bytes);
+  if (index == size_classes) {
+    return ::operator new(bytes);
+  }
+  auto& list = local().lists[index];
+  if (list.head == nullptr) {
+    refill(list, index);
+  }
+  return list.pop();
+}
+
+inline void
+frame_pool::deallocate(void* frame, size_t bytes) noexcept
+{
+  auto index = size_class(bytes);
+  if (index == size_classes) {
+    ::operator delete(frame);
+    return;
+  }
+  auto& list = local().lists[index];
+  list.push(static_cast<free_frame*>(frame));
+  // frames freed on another thread than the one that made them would otherwise pile up here
+  if (list.count >= 2 * batch) {
+    spill(list, index, batch);
+  }
+}
+
+inline size_t
+frame_pool::cached(size_t bytes) noexcept
+{
+  auto index = size_class(bytes);
+  return index == size_classes ? 0 : local().lists[index].count;
+}
+
+inline size_t
+frame_pool::size_class(size_t bytes) noexcept
+{
+  size_t index = 0;
+  while (index < size_classes && class_bytes(index) < bytes) {
+    ++index;
+  }
+  return index;
+}
+
+inline size_t
+frame_pool::class_bytes(size_t index) noexcept
+{
+  return smallest_frame << index;
+}
+
+inline frame_pool::shared_lists&
+frame_pool::shared() noexcept
+{
+  static shared_lists lists;
+  return lists;
+}
+
+inline frame_pool::thread_cache&
+frame_pool::local() noexcept
+{
+  thread_local thread_cache cache;
+  return cache;
+}
+
+inline void
+frame_pool::refill(free_list& list, size_t index)
+{
+  {
+    auto& lists = shared();
+    std::lock_guard<std::mutex> lock{ lists.mutex };
+    auto& source = lists.lists[index];
+    while (source.head != nullptr && list.count < batch) {
+      list.push(source.pop());
+    }
+  }
+  if (list.head != nullptr) {
+    return;
+  }
+  auto bytes = class_bytes(index);
+  auto slab = static_cast<unsigned char*>(::operator new(bytes * batch));
+  for (size_t frame = 0; frame < batch; ++frame) {
+    list.push(reinterpret_cast<free_frame*>(slab + frame * bytes));
+  }
+}
+
+inline void
+frame_pool::spill(free_list& list, size_t index, size_t count) noexcept
+{
+  auto& lists = shared();
+  std::lock_guard<std::mutex> lock{ lists.mutex };
+  for (; count != 0 && list.head != nullptr; --count) {
+    lists.lists[index].push(list.pop());
+  }
+}
+}
\ No newline at end of file
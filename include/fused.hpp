@@ -0,0 +1,95 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+namespace tmf {
+
+inline namespace detail {
+
+// what the last of `StagesT` returns when the first is called with `ValueTs`
+template<typename StagesT, typename... ValueTs>
+struct fused_result;
+
+template<typename StageT, typename... ValueTs>
+struct fused_result<std::tuple<StageT>, ValueTs...>
+{
+  using type = std::invoke_result_t<const StageT&, ValueTs...>;
+};
+
+template<typename StageT, typename NextT, typename... RestTs, typename... ValueTs>
+struct fused_result<std::tuple<StageT, NextT, RestTs...>, ValueTs...>
+{
+  using stage_result = std::invoke_result_t<const StageT&, ValueTs...>;
+  using type = typename std::conditional_t<std::is_void<stage_result>::value,
+                                           fused_result<std::tuple<NextT, RestTs...>>,
+                                           fused_result<std::tuple<NextT, RestTs...>, stage_result>>::type;
+};
+
+template<auto FunctionV>
+struct function_stage
+{
+  template<typename... ValueTs>
+  decltype(auto) operator()(ValueTs&&... values) const
+  {
+    return std::invoke(FunctionV, std::forward<ValueTs>(values)...);
+  }
+};
+}
+
+// a free function as a stage known at compile time, so it is called directly rather than through a pointer
+template<auto FunctionV>
+constexpr function_stage<FunctionV> stage{};
+
+template<typename ArgumentsT, typename... StageTs>
+struct fused;
+
+// a pipeline of stages fused into one concrete type: each stage receives what the previous one returned, or
+// nothing if it returned `void`. held in a `callable` the whole pipeline costs one indirect call, the stages are
+// called directly from it. stages are called as constants
+template<typename... ArgTs, typename... StageTs>
+struct fused<std::tuple<ArgTs...>, StageTs...>
+{
+  using this_type = fused<std::tuple<ArgTs...>, StageTs...>;
+
+  explicit fused(std::tuple<StageTs...> stages);
+
+  // append `next`, which receives the result of the last stage
+  template<typename NextT>
+  fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>> then(NextT&& next) const&;
+
+  template<typename NextT>
+  fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>> then(NextT&& next) &&;
+
+  // what the last stage returns
+  using result_type = typename fused_result<std::tuple<StageTs...>, ArgTs...>::type;
+
+  result_type operator()(ArgTs... arguments) const;
+
+  // check if the fused stages fit in a `callable` of `Capacity`
+  template<size_t Capacity>
+  static constexpr bool fits_in = sizeof(stored_functor_t<this_type, result_type, ArgTs...>) <= Capacity;
+
+  // move the pipeline into a `callable`, failing to compile if it does not fit
+  template<size_t Capacity = default_callable_capacity>
+  callable<result_type(ArgTs...), Capacity> to_callable() const&;
+
+  template<size_t Capacity = default_callable_capacity>
+  callable<result_type(ArgTs...), Capacity> to_callable() &&;
+
+  template<size_t Index, typename... ValueTs>
+  decltype(auto) run(ValueTs&&... values) const;
+
+  std::tuple<StageTs...> m_stages;
+};
+
+// start a pipeline taking `ArgTs` with `first`, add stages with `then`
+template<typename... ArgTs, typename StageT>
+fused<std::tuple<ArgTs...>, std::decay_t<StageT>>
+chain(StageT&& first);
+}
+
+#include "fused.inl"
\ No newline at end of file
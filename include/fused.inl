@@ -0,0 +1,80 @@
+#pragma once
+
+#define FUSED_CAPACITY_ERROR                                                                                           \
+  "the fused stages do not fit in a `tmf::callable` of this capacity! Increase the capacity, capture less state in "  \
+  "the stages, or check `fits_in` before converting."
+
+namespace tmf {
+
+template<typename... ArgTs, typename... StageTs>
+fused<std::tuple<ArgTs...>, StageTs...>::fused(std::tuple<StageTs...> stages)
+  : m_stages(std::move(stages))
+{}
+
+template<typename... ArgTs, typename... StageTs>
+template<typename NextT>
+fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>>
+fused<std::tuple<ArgTs...>, StageTs...>::then(NextT&& next) const&
+{
+  return fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>>{ std::tuple_cat(
+    m_stages, std::tuple<std::decay_t<NextT>>{ std::forward<NextT>(next) }) };
+}
+
+template<typename... ArgTs, typename... StageTs>
+template<typename NextT>
+fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>>
+fused<std::tuple<ArgTs...>, StageTs...>::then(NextT&& next) &&
+{
+  return fused<std::tuple<ArgTs...>, StageTs..., std::decay_t<NextT>>{ std::tuple_cat(
+    std::move(m_stages), std::tuple<std::decay_t<NextT>>{ std::forward<NextT>(next) }) };
+}
+
+template<typename... ArgTs, typename... StageTs>
+typename fused<std::tuple<ArgTs...>, StageTs...>::result_type
+fused<std::tuple<ArgTs...>, StageTs...>::operator()(ArgTs... arguments) const
+{
+  return run<0>(static_cast<ArgTs>(arguments)...);
+}
+
+template<typename... ArgTs, typename... StageTs>
+template<size_t Capacity>
+callable<typename fused<std::tuple<ArgTs...>, StageTs...>::result_type(ArgTs...), Capacity>
+fused<std::tuple<ArgTs...>, StageTs...>::to_callable() const&
+{
+  static_assert(fits_in<Capacity>, FUSED_CAPACITY_ERROR);
+  return callable<result_type(ArgTs...), Capacity>{ this_type{ *this } };
+}
+
+template<typename... ArgTs, typename... StageTs>
+template<size_t Capacity>
+callable<typename fused<std::tuple<ArgTs...>, StageTs...>::result_type(ArgTs...), Capacity>
+fused<std::tuple<ArgTs...>, StageTs...>::to_callable() &&
+{
+  static_assert(fits_in<Capacity>, FUSED_CAPACITY_ERROR);
+  return callable<result_type(ArgTs...), Capacity>{ std::move(*this) };
+}
+
+template<typename... ArgTs, typename... StageTs>
+template<size_t Index, typename... ValueTs>
+decltype(auto)
+fused<std::tuple<ArgTs...>, StageTs...>::run(ValueTs&&... values) const
+{
+  auto& stage = std::get<Index>(m_stages);
+  if constexpr (Index + 1 == sizeof...(StageTs)) {
+    return std::invoke(stage, std::forward<ValueTs>(values)...);
+  } else if constexpr (std::is_void<std::invoke_result_t<decltype(stage), ValueTs...>>::value) {
+    std::invoke(stage, std::forward<ValueTs>(values)...);
+    return run<Index + 1>();
+  } else {
+    return run<Index + 1>(std::invoke(stage, std::forward<ValueTs>(values)...));
+  }
+}
+
+template<typename... ArgTs, typename StageT>
+fused<std::tuple<ArgTs...>, std::decay_t<StageT>>
+chain(StageT&& first)
+{
+  return fused<std::tuple<ArgTs...>, std::decay_t<StageT>>{ std::tuple<std::decay_t<StageT>>{
+    std::forward<StageT>(first) } };
+}
+}
\ No newline at end of file
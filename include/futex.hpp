@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+namespace tmf {
+
+inline namespace detail {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32 bit integers");
+
+// block the calling thread while `word` holds `expected`, may return early for no reason
+inline void
+futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept
+{
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+  if (word.load(std::memory_order_acquire) == expected) {
+    std::this_thread::yield();
+  }
+#endif
+}
+
+// wake up to `count` threads blocked on `word`
+inline void
+futex_wake(std::atomic<uint32_t>& word, int count) noexcept
+{
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+  (void)word;
+  (void)count;
+#endif
+}
+} // namespace detail
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "callable.hpp"
+#include "futex.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+
+namespace tmf {
+
+inline namespace detail {
+
+// stands in for the stored result when a future returns `void`
+struct future_void
+{};
+
+template<typename ResultT>
+using future_value_t = std::conditional_t<std::is_void<ResultT>::value, future_void, ResultT>;
+
+} // namespace detail
+
+template<typename, size_t>
+class packaged_task;
+
+template<typename ResultT>
+class future;
+
+template<typename ResultT, size_t Length>
+class future_arena;
+
+// the state a `packaged_task` and its `future` share, kept in a slot the caller provides or borrowed from a
+// `future_arena`. the slot is busy from `packaged_task::get_future` until both the task and the future are gone,
+// and must outlive them
+template<typename ResultT>
+class future_state
+{
+public:
+  static_assert(!std::is_reference<ResultT>::value, "`tmf::future_state` cannot hold a reference");
+
+  future_state() noexcept;
+
+  future_state(const future_state&) = delete;
+
+  future_state& operator=(const future_state&) = delete;
+
+  // waits for an owner that is still leaving the slot
+  ~future_state();
+
+  // a task or a future still uses the slot
+  bool busy() const noexcept;
+
+private:
+  template<typename, size_t>
+  friend class packaged_task;
+  friend class future<ResultT>;
+  template<typename, size_t>
+  friend class future_arena;
+
+  using value_type = future_value_t<ResultT>;
+
+  // the low bits tell what the slot holds, `waiting` is set while the future sleeps on the word
+  enum status : uint32_t
+  {
+    pending = 0,
+    value = 1,
+    exception = 2,
+    taken = 3,
+    held_mask = 3,
+    waiting = 4
+  };
+
+  // take the free slot for a task and its future
+  bool claim() noexcept;
+
+  // called once by each of the two owners, the last one empties the slot for the next claim
+  void leave() noexcept;
+
+  template<typename... ValueTs>
+  void set_value(ValueTs&&... values);
+
+  void set_exception(std::exception_ptr error) noexcept;
+
+  void publish(uint32_t held) noexcept;
+
+  bool ready() const noexcept;
+
+  void wait() noexcept;
+
+  ResultT take();
+
+  value_type* access() noexcept;
+
+  std::atomic<uint32_t> m_status;
+  std::atomic<uint32_t> m_owners;
+  std::exception_ptr m_exception;
+  std::aligned_storage_t<sizeof(value_type), alignof(value_type)> m_storage;
+};
+
+// the receiving end of a `packaged_task`, blocks on a futex until the result is published
+template<typename ResultT>
+class future
+{
+public:
+  // a future without state, as left behind by a move or `get`
+  future() noexcept;
+
+  future(future&& other) noexcept;
+
+  future& operator=(future&& rhs) noexcept;
+
+  future(const future&) = delete;
+
+  future& operator=(const future&) = delete;
+
+  ~future();
+
+  // check if there is a state to wait on
+  bool valid() const noexcept;
+
+  // check if the result has been published, without waiting
+  bool ready() const;
+
+  // block until the result has been published
+  void wait() const;
+
+  // wait for the result and return it, or rethrow what the task threw. leaves the future without state
+  ResultT get();
+
+private:
+  template<typename, size_t>
+  friend class packaged_task;
+
+  explicit future(future_state<ResultT>* state) noexcept;
+
+  future_state<ResultT>* m_state;
+};
+
+// a fixed set of `Length` future slots, for callers that cannot keep a slot alive themselves. a slot returns to the
+// arena once its task and future are gone
+template<typename ResultT, size_t Length>
+class future_arena
+{
+public:
+  future_arena() noexcept;
+
+  future_arena(const future_arena&) = delete;
+
+  future_arena& operator=(const future_arena&) = delete;
+
+  // a free slot, or nullptr if they are all busy
+  future_state<ResultT>* acquire() noexcept;
+
+  static constexpr size_t length() noexcept { return Length; }
+
+private:
+  std::atomic<size_t> m_cursor;
+  future_state<ResultT> m_slots[Length];
+};
+}
+
+#include "future.inl"
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <climits>
+#include <new>
+#include <thread>
+
+namespace tmf {
+
+template<typename ResultT>
+future_state<ResultT>::future_state() noexcept
+  : m_status(pending)
+  , m_owners(0)
+{}
+
+template<typename ResultT>
+future_state<ResultT>::~future_state()
+{
+  // the last owner may still be emptying the slot after the other one has moved on
+  while (busy()) {
+    std::this_thread::yield();
+  }
+  if ((m_status.load(std::memory_order_acquire) & held_mask) == value) {
+    access()->~value_type();
+  }
+}
+
+template<typename ResultT>
+bool
+future_state<ResultT>::busy() const noexcept
+{
+  return m_owners.load(std::memory_order_acquire) != 0;
+}
+
+template<typename ResultT>
+bool
+future_state<ResultT>::claim() noexcept
+{
+  uint32_t expected = 0;
+  return m_owners.compare_exchange_strong(expected, 2, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+template<typename ResultT>
+void
+future_state<ResultT>::leave() noexcept
+{
+  auto owners = m_owners.load(std::memory_order_acquire);
+  while (owners == 2 && !m_owners.compare_exchange_weak(owners, 1, std::memory_order_acq_rel)) {
+  }
+  if (owners == 2) {
+    return;
+  }
+  // the other owner has left for good, so nothing races the reset
+  if ((m_status.load(std::memory_order_acquire) & held_mask) == value) {
+    access()->~value_type();
+  }
+  m_exception = nullptr;
+  m_status.store(pending, std::memory_order_relaxed);
+  m_owners.store(0, std::memory_order_release);
+}
+
+template<typename ResultT>
+template<typename... ValueTs>
+void
+future_state<ResultT>::set_value(ValueTs&&... values)
+{
+  new (access()) value_type(std::forward<ValueTs>(values)...);
+  publish(value);
+}
+
+template<typename ResultT>
+void
+future_state<ResultT>::set_exception(std::exception_ptr error) noexcept
+{
+  m_exception = std::move(error);
+  publish(exception);
+}
+
+template<typename ResultT>
+void
+future_state<ResultT>::publish(uint32_t held) noexcept
+{
+  // only wake the future if it went to sleep, otherwise publishing costs one exchange
+  if (m_status.exchange(held, std::memory_order_acq_rel) & waiting) {
+    futex_wake(m_status, INT_MAX);
+  }
+}
+
+template<typename ResultT>
+bool
+future_state<ResultT>::ready() const noexcept
+{
+  return (m_status.load(std::memory_order_acquire) & held_mask) != pending;
+}
+
+template<typename ResultT>
+void
+future_state<ResultT>::wait() noexcept
+{
+  auto status = m_status.load(std::memory_order_acquire);
+  while ((status & held_mask) == pending) {
+    if ((status & waiting) == 0 &&
+        !m_status.compare_exchange_weak(status, status | waiting, std::memory_order_acquire)) {
+      continue;
+    }
+    futex_wait(m_status, status | waiting);
+    status = m_status.load(std::memory_order_acquire);
+  }
+}
+
+template<typename ResultT>
+ResultT
+future_state<ResultT>::take()
+{
+  wait();
+  if ((m_status.load(std::memory_order_acquire) & held_mask) == exception) {
+    std::rethrow_exception(m_exception);
+  }
+  m_status.store(taken, std::memory_order_relaxed);
+  if constexpr (std::is_void<ResultT>::value) {
+    return;
+  } else {
+    // destroy the stored value once it has been moved into the result, even if the move throws
+    struct destroy
+    {
+      ~destroy() { value->~value_type(); }
+      value_type* value;
+    } destroyed{ access() };
+    return std::move(*destroyed.value);
+  }
+}
+
+template<typename ResultT>
+typename future_state<ResultT>::value_type*
+future_state<ResultT>::access() noexcept
+{
+  return std::launder(reinterpret_cast<value_type*>(&m_storage));
+}
+
+template<typename ResultT>
+future<ResultT>::future() noexcept
+  : m_state(nullptr)
+{}
+
+template<typename ResultT>
+future<ResultT>::future(future_state<ResultT>* state) noexcept
+  : m_state(state)
+{}
+
+template<typename ResultT>
+future<ResultT>::future(future&& other) noexcept
+  : m_state(other.m_state)
+{
+  other.m_state = nullptr;
+}
+
+template<typename ResultT>
+future<ResultT>&
+future<ResultT>::operator=(future&& rhs) noexcept
+{
+  if (this != &rhs) {
+    if (m_state != nullptr) {
+      m_state->leave();
+    }
+    m_state = rhs.m_state;
+    rhs.m_state = nullptr;
+  }
+  return *this;
+}
+
+template<typename ResultT>
+future<ResultT>::~future()
+{
+  if (m_state != nullptr) {
+    m_state->leave();
+  }
+}
+
+template<typename ResultT>
+bool
+future<ResultT>::valid() const noexcept
+{
+  return m_state != nullptr;
+}
+
+template<typename ResultT>
+bool
+future<ResultT>::ready() const
+{
+  if (m_state == nullptr) {
+    throw callable_exception{ "attempted to use a future without state." };
+  }
+  return m_state->ready();
+}
+
+template<typename ResultT>
+void
+future<ResultT>::wait() const
+{
+  if (m_state == nullptr) {
+    throw callable_exception{ "attempted to use a future without state." };
+  }
+  m_state->wait();
+}
+
+template<typename ResultT>
+ResultT
+future<ResultT>::get()
+{
+  if (m_state == nullptr) {
+    throw callable_exception{ "attempted to use a future without state." };
+  }
+  // give the slot back on the way out, whether the task returned or threw
+  struct release
+  {
+    ~release() { state->leave(); }
+    future_state<ResultT>* state;
+  } released{ m_state };
+  m_state = nullptr;
+  return released.state->take();
+}
+
+template<typename ResultT, size_t Length>
+future_arena<ResultT, Length>::future_arena() noexcept
+  : m_cursor(0)
+{}
+
+template<typename ResultT, size_t Length>
+future_state<ResultT>*
+future_arena<ResultT, Length>::acquire() noexcept
+{
+  // start where the last search left off, slots are usually given back in the order they were taken
+  auto first = m_cursor.fetch_add(1, std::memory_order_relaxed);
+  for (size_t offset = 0; offset < Length; ++offset) {
+    auto& slot = m_slots[(first + offset) % Length];
+    if (slot.claim()) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+}
\ No newline at end of file
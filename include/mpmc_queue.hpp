@@ -0,0 +1,60 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace tmf {
+
+// a bounded lock-free multi-producer/multi-consumer queue of tasks. each of the `Length` cells embeds a
+// `callable<void(), Capacity>`, tasks are relocated in and out of it with the callable's mover, and nothing is
+// ever allocated. `Length` must be a power of two
+template<size_t Length, size_t Capacity = default_callable_capacity>
+struct mpmc_queue
+{
+  static_assert(Length >= 2 && (Length & (Length - 1)) == 0, "`tmf::mpmc_queue` length must be a power of two");
+
+  using task_type = callable<void(), Capacity>;
+  using this_type = mpmc_queue<Length, Capacity>;
+
+  mpmc_queue() noexcept;
+
+  mpmc_queue(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // move `task` into the queue, unless the queue is full
+  bool try_push(task_type&& task) noexcept;
+
+  // build a task from `sources`, taking any sources a `callable` can be constructed with, and push it
+  template<typename... SourceTs>
+  bool try_emplace(SourceTs&&... sources) noexcept;
+
+  // move the oldest task into `task`, unless the queue is empty
+  bool try_pop(task_type& task) noexcept;
+
+  // a snapshot that may be stale by the time it returns
+  size_t size() const noexcept;
+
+  bool empty() const noexcept;
+
+  static constexpr size_t length() noexcept { return Length; }
+
+private:
+  // `sequence` tells whose turn the cell is: equal to a producer's position when it may fill the cell, one past
+  // a consumer's position when it may empty it
+  struct cell
+  {
+    std::atomic<size_t> sequence;
+    task_type task;
+  };
+
+  // producers and consumers each keep their position on their own cache line
+  alignas(64) std::atomic<size_t> m_enqueue_position;
+  alignas(64) std::atomic<size_t> m_dequeue_position;
+  alignas(64) cell m_cells[Length];
+};
+}
+
+#include "mpmc_queue.inl"
\ No newline at end of file
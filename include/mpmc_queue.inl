@@ -0,0 +1,90 @@
+#pragma once
+
+namespace tmf {
+
+template<size_t Length, size_t Capacity>
+mpmc_queue<Length, Capacity>::mpmc_queue() noexcept
+  : m_enqueue_position(0)
+  , m_dequeue_position(0)
+{
+  for (size_t index = 0; index < Length; ++index) {
+    m_cells[index].sequence.store(index, std::memory_order_relaxed);
+  }
+}
+
+template<size_t Length, size_t Capacity>
+bool
+mpmc_queue<Length, Capacity>::try_push(task_type&& task) noexcept
+{
+  auto position = m_enqueue_position.load(std::memory_order_relaxed);
+  cell* claimed;
+  for (;;) {
+    claimed = &m_cells[position & (Length - 1)];
+    auto sequence = claimed->sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+    if (difference == 0) {
+      if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // the cell still holds the task pushed one lap ago
+      return false;
+    } else {
+      position = m_enqueue_position.load(std::memory_order_relaxed);
+    }
+  }
+  claimed->task = std::move(task);
+  claimed->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+template<typename... SourceTs>
+bool
+mpmc_queue<Length, Capacity>::try_emplace(SourceTs&&... sources) noexcept
+{
+  return try_push(task_type{ std::forward<SourceTs>(sources)... });
+}
+
+template<size_t Length, size_t Capacity>
+bool
+mpmc_queue<Length, Capacity>::try_pop(task_type& task) noexcept
+{
+  auto position = m_dequeue_position.load(std::memory_order_relaxed);
+  cell* claimed;
+  for (;;) {
+    claimed = &m_cells[position & (Length - 1)];
+    auto sequence = claimed->sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+    if (difference == 0) {
+      if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // nothing has been pushed into the cell yet
+      return false;
+    } else {
+      position = m_dequeue_position.load(std::memory_order_relaxed);
+    }
+  }
+  task = std::move(claimed->task);
+  claimed->sequence.store(position + Length, std::memory_order_release);
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+mpmc_queue<Length, Capacity>::size() const noexcept
+{
+  auto enqueued = m_enqueue_position.load(std::memory_order_relaxed);
+  auto dequeued = m_dequeue_position.load(std::memory_order_relaxed);
+  return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+mpmc_queue<Length, Capacity>::empty() const noexcept
+{
+  return size() == 0;
+}
+}
\ No newline at end of file
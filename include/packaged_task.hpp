@@ -0,0 +1,65 @@
+#pragma once
+
+#include "callable.hpp"
+#include "future.hpp"
+
+#include <type_traits>
+
+namespace tmf {
+
+template<typename, size_t = default_callable_capacity>
+class packaged_task;
+
+// a callable target whose result, or exception, is handed to a `future`. the target lives in `callable` storage
+// and the shared state in a `future_state` slot, so neither allocates
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+class packaged_task<ReturnT(ArgTs...), Capacity>
+{
+public:
+  using target_type = callable<ReturnT(ArgTs...), Capacity>;
+  using this_type = packaged_task<ReturnT(ArgTs...), Capacity>;
+
+  // a task without a target
+  packaged_task() noexcept;
+
+  // build the target from `sources`, taking any sources a `callable` can be constructed with
+  template<typename SourceT,
+           typename... SourceTs,
+           typename = std::enable_if_t<!std::is_same<std::decay_t<SourceT>, this_type>::value>>
+  explicit packaged_task(SourceT&& source, SourceTs&&... sources) noexcept;
+
+  packaged_task(this_type&& other) noexcept;
+
+  this_type& operator=(this_type&& rhs) noexcept;
+
+  packaged_task(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // a task destroyed before it ran leaves an exception in its future
+  ~packaged_task();
+
+  // check if there is a target to run
+  bool valid() const noexcept;
+
+  // share `slot` with the returned future, the slot must be free and outlive both
+  future<ReturnT> get_future(future_state<ReturnT>& slot);
+
+  // share a slot borrowed from `arena` with the returned future
+  template<size_t Length>
+  future<ReturnT> get_future(future_arena<ReturnT, Length>& arena);
+
+  // run the target once and publish its result, or what it threw, to the future
+  void operator()(ArgTs... arguments);
+
+private:
+  future<ReturnT> attach(future_state<ReturnT>* state);
+
+  void abandon() noexcept;
+
+  target_type m_target;
+  future_state<ReturnT>* m_state;
+};
+}
+
+#include "packaged_task.inl"
\ No newline at end of file
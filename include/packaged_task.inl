@@ -0,0 +1,119 @@
+#pragma once
+
+namespace tmf {
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+packaged_task<ReturnT(ArgTs...), Capacity>::packaged_task() noexcept
+  : m_state(nullptr)
+{}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+template<typename SourceT, typename... SourceTs, typename>
+packaged_task<ReturnT(ArgTs...), Capacity>::packaged_task(SourceT&& source, SourceTs&&... sources) noexcept
+  : m_target(std::forward<SourceT>(source), std::forward<SourceTs>(sources)...)
+  , m_state(nullptr)
+{}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+packaged_task<ReturnT(ArgTs...), Capacity>::packaged_task(this_type&& other) noexcept
+  : m_target(std::move(other.m_target))
+  , m_state(other.m_state)
+{
+  other.m_state = nullptr;
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+packaged_task<ReturnT(ArgTs...), Capacity>&
+packaged_task<ReturnT(ArgTs...), Capacity>::operator=(this_type&& rhs) noexcept
+{
+  if (this != &rhs) {
+    abandon();
+    m_target = std::move(rhs.m_target);
+    m_state = rhs.m_state;
+    rhs.m_state = nullptr;
+  }
+  return *this;
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+packaged_task<ReturnT(ArgTs...), Capacity>::~packaged_task()
+{
+  abandon();
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+bool
+packaged_task<ReturnT(ArgTs...), Capacity>::valid() const noexcept
+{
+  return !m_target.empty();
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+future<ReturnT>
+packaged_task<ReturnT(ArgTs...), Capacity>::get_future(future_state<ReturnT>& slot)
+{
+  if (m_state != nullptr) {
+    throw callable_exception{ "the future of a packaged task was already retrieved." };
+  }
+  if (!slot.claim()) {
+    throw callable_exception{ "attempted to share a future slot that is still in use." };
+  }
+  return attach(&slot);
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+template<size_t Length>
+future<ReturnT>
+packaged_task<ReturnT(ArgTs...), Capacity>::get_future(future_arena<ReturnT, Length>& arena)
+{
+  if (m_state != nullptr) {
+    throw callable_exception{ "the future of a packaged task was already retrieved." };
+  }
+  auto slot = arena.acquire();
+  if (slot == nullptr) {
+    throw callable_exception{ "every slot of the future arena is in use." };
+  }
+  return attach(slot);
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+void
+packaged_task<ReturnT(ArgTs...), Capacity>::operator()(ArgTs... arguments)
+{
+  if (m_state == nullptr) {
+    throw callable_exception{ "attempted to run a packaged task without a future." };
+  }
+  auto state = m_state;
+  m_state = nullptr;
+  try {
+    if constexpr (std::is_void<ReturnT>::value) {
+      m_target(static_cast<ArgTs>(arguments)...);
+      state->set_value();
+    } else {
+      state->set_value(m_target(static_cast<ArgTs>(arguments)...));
+    }
+  } catch (...) {
+    state->set_exception(std::current_exception());
+  }
+  state->leave();
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+future<ReturnT>
+packaged_task<ReturnT(ArgTs...), Capacity>::attach(future_state<ReturnT>* state)
+{
+  m_state = state;
+  return future<ReturnT>{ state };
+}
+
+template<typename ReturnT, typename... ArgTs, size_t Capacity>
+void
+packaged_task<ReturnT(ArgTs...), Capacity>::abandon() noexcept
+{
+  if (m_state != nullptr) {
+    m_state->set_exception(std::make_exception_ptr(callable_exception{ "a packaged task was destroyed before it ran." }));
+    m_state->leave();
+    m_state = nullptr;
+  }
+}
+}
\ No newline at end of file
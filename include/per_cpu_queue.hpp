@@ -0,0 +1,61 @@
+#pragma once
+
+#include "callable.hpp"
+#include "mpmc_queue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace tmf {
+
+// a front-end of `mpmc_queue`s, one per CPU: producers push to the queue of the CPU they run on, consumers drain
+// theirs before taking from the others. the CPU comes from the restartable sequence area the C library registers
+// for every thread on Linux, which costs a load. where there is no such area each thread keeps to a queue of its
+// own instead, handed out round robin. either way producers on different CPUs or threads rarely touch the same
+// cache lines. `Length` is the number of cells per queue and must be a power of two
+template<size_t Length = 256, size_t Capacity = default_callable_capacity>
+class per_cpu_queue
+{
+public:
+  using queue_type = mpmc_queue<Length, Capacity>;
+  using task_type = typename queue_type::task_type;
+
+  // one queue per CPU, at least one. CPUs beyond `queues` share
+  explicit per_cpu_queue(size_t queues = std::thread::hardware_concurrency());
+
+  per_cpu_queue(const per_cpu_queue&) = delete;
+
+  per_cpu_queue& operator=(const per_cpu_queue&) = delete;
+
+  // build a task from `sources`, taking any sources a `callable` can be constructed with, and push it to the local
+  // queue, or the next one that is not full. returns false when every queue is full
+  template<typename... SourceTs>
+  bool try_post(SourceTs&&... sources);
+
+  // pop a task from the local queue, or the next one that is not empty, and run it. returns false when every
+  // queue is empty
+  bool run_one();
+
+  // run tasks from the local queue only, until it is empty, and return how many ran
+  size_t run_local();
+
+  // a snapshot of the tasks in every queue, that may be stale by the time it returns
+  size_t size() const noexcept;
+
+  size_t queues() const noexcept;
+
+  // the queue of the calling thread
+  size_t local() const noexcept;
+
+  // the CPU the calling thread runs on according to its restartable sequence area, or -1 without one
+  static int current_cpu() noexcept;
+
+private:
+  std::unique_ptr<queue_type[]> m_queues;
+  size_t m_count;
+};
+}
+
+#include "per_cpu_queue.inl"
\ No newline at end of file
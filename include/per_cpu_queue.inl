@@ -0,0 +1,111 @@
+#pragma once
+
+#if defined(__linux__) && __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define TMF_PER_CPU_RSEQ 1
+#else
+#define TMF_PER_CPU_RSEQ 0
+#endif
+
+namespace tmf {
+
+template<size_t Length, size_t Capacity>
+per_cpu_queue<Length, Capacity>::per_cpu_queue(size_t queues)
+  : m_queues(new queue_type[queues == 0 ? 1 : queues])
+  , m_count(queues == 0 ? 1 : queues)
+{}
+
+template<size_t Length, size_t Capacity>
+template<typename... SourceTs>
+bool
+per_cpu_queue<Length, Capacity>::try_post(SourceTs&&... sources)
+{
+  task_type task{ std::forward<SourceTs>(sources)... };
+  auto first = local();
+  for (size_t offset = 0; offset < m_count; ++offset) {
+    if (m_queues[(first + offset) % m_count].try_push(std::move(task))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+per_cpu_queue<Length, Capacity>::run_one()
+{
+  task_type task;
+  auto first = local();
+  for (size_t offset = 0; offset < m_count; ++offset) {
+    if (m_queues[(first + offset) % m_count].try_pop(task)) {
+      task();
+      return true;
+    }
+  }
+  return false;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+per_cpu_queue<Length, Capacity>::run_local()
+{
+  task_type task;
+  size_t ran = 0;
+  // the thread may move to another CPU while it runs, it keeps draining the queue it started with
+  for (auto& queue = m_queues[local()]; queue.try_pop(task); ++ran) {
+    task();
+  }
+  return ran;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+per_cpu_queue<Length, Capacity>::size() const noexcept
+{
+  size_t total = 0;
+  for (size_t index = 0; index < m_count; ++index) {
+    total += m_queues[index].size();
+  }
+  return total;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+per_cpu_queue<Length, Capacity>::queues() const noexcept
+{
+  return m_count;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+per_cpu_queue<Length, Capacity>::local() const noexcept
+{
+  auto cpu = current_cpu();
+  if (cpu >= 0) {
+    return static_cast<size_t>(cpu) % m_count;
+  }
+  static std::atomic<size_t> next_thread{ 0 };
+  thread_local size_t thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+  return thread % m_count;
+}
+
+template<size_t Length, size_t Capacity>
+int
+per_cpu_queue<Length, Capacity>::current_cpu() noexcept
+{
+#if TMF_PER_CPU_RSEQ
+  // the C library registers the area and publishes where it lives in the thread control block. the kernel
+  // rewrites `cpu_id` whenever the thread migrates, and leaves it negative while the area is unregistered
+  if (__rseq_size == 0) {
+    return -1;
+  }
+  auto area = reinterpret_cast<const volatile struct rseq*>(static_cast<const char*>(__builtin_thread_pointer()) +
+                                                            __rseq_offset);
+  return static_cast<int>(area->cpu_id);
+#else
+  return -1;
+#endif
+}
+}
+
+#undef TMF_PER_CPU_RSEQ
\ No newline at end of file
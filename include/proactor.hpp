@@ -0,0 +1,118 @@
+#pragma once
+
+#include "callable.hpp"
+#include "thread_pool.hpp"
+
+#if defined(__linux__)
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace tmf {
+
+// a completion loop over io_uring, driven through the raw system calls. every operation takes a slot from a pool
+// fixed at construction, the slot holds its completion handler inline and the submission carries the slot's
+// address, so completing an operation is a load and one indirect call. operations are queued and submitted in
+// batches. where io_uring is unavailable, or `emulate` asks for it, blocking calls on a `thread_pool` stand in for
+// the kernel. not thread-safe, handlers run on the thread calling `run_once`
+template<size_t Capacity = default_callable_capacity>
+class proactor
+{
+public:
+  // called with what the system call returned, or minus the error number
+  using handler_type = callable<void(int), Capacity>;
+
+  // room for at least `entries` queued and `entries` in flight operations
+  explicit proactor(unsigned entries, bool emulate = false);
+
+  proactor(const proactor&) = delete;
+
+  proactor& operator=(const proactor&) = delete;
+
+  // operations still in flight are cancelled or waited for, their handlers are not called
+  ~proactor();
+
+  // queue a `pread` of `fd` into `buffer`, calling a handler built from `sources`, taking any sources a
+  // `callable` can be constructed with, once it completes. throws if every slot is in use, or if the submission
+  // queue is full and the kernel will not take any of it yet
+  template<typename... SourceTs>
+  void read(int fd, void* buffer, unsigned length, std::uint64_t offset, SourceTs&&... sources);
+
+  // queue a `pwrite` of `buffer` to `fd`, as `read`
+  template<typename... SourceTs>
+  void write(int fd, const void* buffer, unsigned length, std::uint64_t offset, SourceTs&&... sources);
+
+  // hand every queued operation to the kernel in one call, returns how many
+  unsigned submit();
+
+  // submit, wait for at least one completion if `wait` and anything is in flight, then run every completion
+  // handler ready and return how many ran. a handler that throws gives its slot back and the exception escapes,
+  // completions that did not run yet stay ready for the next call
+  size_t run_once(bool wait = true);
+
+  // operations queued or submitted whose handler has not run yet
+  size_t in_flight() const noexcept;
+
+  bool emulated() const noexcept;
+
+private:
+  struct slot
+  {
+    handler_type handler;
+    // the next free, queued or completed slot
+    slot* next = nullptr;
+    // what an emulated operation does and what it returned
+    bool writing = false;
+    int fd = -1;
+    void* buffer = nullptr;
+    unsigned length = 0;
+    std::uint64_t offset = 0;
+    int result = 0;
+  };
+
+  template<typename... SourceTs>
+  void queue(bool writing, int fd, void* buffer, unsigned length, std::uint64_t offset, SourceTs&&... sources);
+
+  bool setup_ring(unsigned entries);
+
+  void release(slot* done) noexcept;
+
+  // push the emulated completions from `oldest` on back onto `m_completed`, keeping their order
+  void requeue(slot* oldest) noexcept;
+
+  size_t run_ring(bool wait);
+
+  size_t run_emulated(bool wait);
+
+  std::unique_ptr<slot[]> m_slots;
+  slot* m_free;
+  size_t m_in_flight;
+  unsigned m_queued;
+
+  // the rings shared with the kernel, `m_ring` is -1 when emulated
+  int m_ring;
+  void* m_sq_memory;
+  size_t m_sq_size;
+  void* m_cq_memory;
+  size_t m_cq_size;
+  void* m_sqes;
+  size_t m_sqes_size;
+  unsigned* m_sq_tail;
+  unsigned m_sq_mask;
+  unsigned m_sq_entries;
+  unsigned* m_sq_array;
+  unsigned* m_cq_head;
+  unsigned* m_cq_tail;
+  unsigned m_cq_mask;
+  void* m_cqes;
+
+  // emulation: queued slots, and slots the workers completed pushed onto a stack
+  slot* m_pending;
+  std::atomic<slot*> m_completed;
+  std::atomic<uint32_t> m_completions;
+  std::unique_ptr<thread_pool<>> m_pool;
+};
+}
+
+#include "proactor.inl"
+#endif
\ No newline at end of file
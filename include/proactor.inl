@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define TMF_PROACTOR_IO_URING 1
+#else
+#define TMF_PROACTOR_IO_URING 0
+#endif
+
+namespace tmf {
+
+inline namespace detail {
+
+static_assert(sizeof(std::atomic<unsigned>) == sizeof(unsigned), "ring indices must be plain 32 bit integers");
+
+// the ring indices are shared with the kernel, which reads the submission tail and writes the completion tail
+inline unsigned
+ring_load(unsigned* index) noexcept
+{
+  return reinterpret_cast<std::atomic<unsigned>*>(index)->load(std::memory_order_acquire);
+}
+
+inline void
+ring_store(unsigned* index, unsigned value) noexcept
+{
+  reinterpret_cast<std::atomic<unsigned>*>(index)->store(value, std::memory_order_release);
+}
+} // namespace detail
+
+template<size_t Capacity>
+proactor<Capacity>::proactor(unsigned entries, bool emulate)
+  : m_free(nullptr)
+  , m_in_flight(0)
+  , m_queued(0)
+  , m_ring(-1)
+  , m_sq_memory(nullptr)
+  , m_sq_size(0)
+  , m_cq_memory(nullptr)
+  , m_cq_size(0)
+  , m_sqes(nullptr)
+  , m_sqes_size(0)
+  , m_sq_tail(nullptr)
+  , m_sq_mask(0)
+  , m_sq_entries(0)
+  , m_sq_array(nullptr)
+  , m_cq_head(nullptr)
+  , m_cq_tail(nullptr)
+  , m_cq_mask(0)
+  , m_cqes(nullptr)
+  , m_pending(nullptr)
+  , m_completed(nullptr)
+  , m_completions(0)
+{
+  if (entries == 0) {
+    throw callable_exception{ "a proactor needs at least one entry." };
+  }
+  // the completion ring holds twice the submission ring, one slot per completion keeps it from overflowing
+  size_t slots = size_t{ entries } * 2;
+  if (emulate || !setup_ring(entries)) {
+    m_pool.reset(new thread_pool<>{});
+  } else {
+    slots = m_cq_mask + 1;
+  }
+  m_slots.reset(new slot[slots]);
+  for (size_t index = slots; index-- > 0;) {
+    m_slots[index].next = m_free;
+    m_free = &m_slots[index];
+  }
+}
+
+template<size_t Capacity>
+proactor<Capacity>::~proactor()
+{
+  if (m_ring != -1) {
+    // the kernel may still be writing to buffers the caller is about to free
+    while (m_in_flight != 0) {
+      submit();
+#if TMF_PROACTOR_IO_URING
+      ::syscall(__NR_io_uring_enter, m_ring, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      auto head = *m_cq_head;
+      for (auto tail = ring_load(m_cq_tail); head != tail; ++head) {
+        --m_in_flight;
+      }
+      ring_store(m_cq_head, head);
+#endif
+    }
+    ::munmap(m_sqes, m_sqes_size);
+    if (m_cq_memory != m_sq_memory) {
+      ::munmap(m_cq_memory, m_cq_size);
+    }
+    ::munmap(m_sq_memory, m_sq_size);
+    ::close(m_ring);
+  } else {
+    submit();
+    // runs every posted operation, then joins the workers
+    m_pool.reset();
+  }
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+void
+proactor<Capacity>::read(int fd, void* buffer, unsigned length, std::uint64_t offset, SourceTs&&... sources)
+{
+  queue(false, fd, buffer, length, offset, std::forward<SourceTs>(sources)...);
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+void
+proactor<Capacity>::write(int fd, const void* buffer, unsigned length, std::uint64_t offset, SourceTs&&... sources)
+{
+  queue(true, fd, const_cast<void*>(buffer), length, offset, std::forward<SourceTs>(sources)...);
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+void
+proactor<Capacity>::queue(bool writing,
+                          int fd,
+                          void* buffer,
+                          unsigned length,
+                          std::uint64_t offset,
+                          SourceTs&&... sources)
+{
+  if (m_free == nullptr) {
+    throw callable_exception{ "every slot of the proactor is in use." };
+  }
+  if (m_ring != -1 && m_queued == m_sq_entries) {
+    // an entry is only free once the kernel has taken it, writing past them would overwrite a queued operation
+    submit();
+    if (m_queued == m_sq_entries) {
+      throw callable_exception{ "the submission queue of the proactor is full." };
+    }
+  }
+  auto operation = m_free;
+  operation->handler = handler_type{ std::forward<SourceTs>(sources)... };
+  m_free = operation->next;
+  ++m_in_flight;
+  if (m_ring == -1) {
+    operation->writing = writing;
+    operation->fd = fd;
+    operation->buffer = buffer;
+    operation->length = length;
+    operation->offset = offset;
+    operation->next = m_pending;
+    m_pending = operation;
+    ++m_queued;
+    return;
+  }
+#if TMF_PROACTOR_IO_URING
+  auto tail = *m_sq_tail;
+  auto index = tail & m_sq_mask;
+  auto& entry = static_cast<io_uring_sqe*>(m_sqes)[index];
+  std::memset(&entry, 0, sizeof(entry));
+  entry.opcode = writing ? IORING_OP_WRITE : IORING_OP_READ;
+  entry.fd = fd;
+  entry.off = offset;
+  entry.addr = reinterpret_cast<std::uint64_t>(buffer);
+  entry.len = length;
+  entry.user_data = reinterpret_cast<std::uint64_t>(operation);
+  m_sq_array[index] = index;
+  ring_store(m_sq_tail, tail + 1);
+  ++m_queued;
+#endif
+}
+
+template<size_t Capacity>
+unsigned
+proactor<Capacity>::submit()
+{
+  auto queued = m_queued;
+  if (queued == 0) {
+    return 0;
+  }
+  if (m_ring == -1) {
+    for (auto operation = m_pending; operation != nullptr;) {
+      auto next = operation->next;
+      m_pool->post([this, operation] {
+        auto done = operation->writing ? ::pwrite(operation->fd, operation->buffer, operation->length, operation->offset)
+                                       : ::pread(operation->fd, operation->buffer, operation->length, operation->offset);
+        operation->result = done < 0 ? -errno : static_cast<int>(done);
+        auto head = m_completed.load(std::memory_order_relaxed);
+        do {
+          operation->next = head;
+        } while (!m_completed.compare_exchange_weak(
+          head, operation, std::memory_order_release, std::memory_order_relaxed));
+        m_completions.fetch_add(1, std::memory_order_release);
+        futex_wake(m_completions, 1);
+      });
+      operation = next;
+    }
+    m_pending = nullptr;
+    m_queued = 0;
+    return queued;
+  }
+#if TMF_PROACTOR_IO_URING
+  auto submitted = ::syscall(__NR_io_uring_enter, m_ring, queued, 0, 0, nullptr, 0);
+  if (submitted < 0) {
+    // a full completion ring or a lack of kernel memory, the queued operations go with the next call
+    if (errno == EAGAIN || errno == EBUSY || errno == EINTR) {
+      return 0;
+    }
+    throw callable_exception{ std::string{ "io_uring_enter failed: " } + std::strerror(errno) };
+  }
+  m_queued -= static_cast<unsigned>(submitted);
+  return static_cast<unsigned>(submitted);
+#else
+  return 0;
+#endif
+}
+
+template<size_t Capacity>
+size_t
+proactor<Capacity>::run_once(bool wait)
+{
+  return m_ring == -1 ? run_emulated(wait) : run_ring(wait);
+}
+
+template<size_t Capacity>
+size_t
+proactor<Capacity>::in_flight() const noexcept
+{
+  return m_in_flight;
+}
+
+template<size_t Capacity>
+bool
+proactor<Capacity>::emulated() const noexcept
+{
+  return m_ring == -1;
+}
+
+template<size_t Capacity>
+bool
+proactor<Capacity>::setup_ring(unsigned entries)
+{
+#if TMF_PROACTOR_IO_URING
+  io_uring_params parameters{};
+  auto ring = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &parameters));
+  if (ring < 0) {
+    // no kernel support, or a sandbox that forbids it
+    return false;
+  }
+  m_sq_size = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+  m_cq_size = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+  bool single = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single) {
+    m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+  }
+  m_sqes_size = parameters.sq_entries * sizeof(io_uring_sqe);
+  auto map = [ring](size_t size, off_t offset) {
+    auto memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+    return memory == MAP_FAILED ? nullptr : memory;
+  };
+  m_sq_memory = map(m_sq_size, IORING_OFF_SQ_RING);
+  m_cq_memory = single ? m_sq_memory : map(m_cq_size, IORING_OFF_CQ_RING);
+  m_sqes = map(m_sqes_size, IORING_OFF_SQES);
+  if (m_sq_memory == nullptr || m_cq_memory == nullptr || m_sqes == nullptr) {
+    for (auto [memory, size] : { std::pair{ m_sqes, m_sqes_size }, std::pair{ m_sq_memory, m_sq_size } }) {
+      if (memory != nullptr) {
+        ::munmap(memory, size);
+      }
+    }
+    if (!single && m_cq_memory != nullptr) {
+      ::munmap(m_cq_memory, m_cq_size);
+    }
+    ::close(ring);
+    return false;
+  }
+  auto sq = static_cast<char*>(m_sq_memory);
+  auto cq = static_cast<char*>(m_cq_memory);
+  m_sq_tail = reinterpret_cast<unsigned*>(sq + parameters.sq_off.tail);
+  m_sq_mask = *reinterpret_cast<unsigned*>(sq + parameters.sq_off.ring_mask);
+  m_sq_entries = parameters.sq_entries;
+  m_sq_array = reinterpret_cast<unsigned*>(sq + parameters.sq_off.array);
+  m_cq_head = reinterpret_cast<unsigned*>(cq + parameters.cq_off.head);
+  m_cq_tail = reinterpret_cast<unsigned*>(cq + parameters.cq_off.tail);
+  m_cq_mask = *reinterpret_cast<unsigned*>(cq + parameters.cq_off.ring_mask);
+  m_cqes = cq + parameters.cq_off.cqes;
+  m_ring = ring;
+  return true;
+#else
+  (void)entries;
+  return false;
+#endif
+}
+
+template<size_t Capacity>
+void
+proactor<Capacity>::release(slot* done) noexcept
+{
+  done->handler = handler_type{};
+  done->next = m_free;
+  m_free = done;
+  --m_in_flight;
+}
+
+template<size_t Capacity>
+size_t
+proactor<Capacity>::run_ring(bool wait)
+{
+#if TMF_PROACTOR_IO_URING
+  auto head = *m_cq_head;
+  bool ready = head != ring_load(m_cq_tail);
+  if (m_queued != 0 || (wait && !ready && m_in_flight != 0)) {
+    unsigned waiting = wait && !ready && m_in_flight != 0 ? 1 : 0;
+    auto submitted = ::syscall(
+      __NR_io_uring_enter, m_ring, m_queued, waiting, waiting != 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+    if (submitted >= 0) {
+      m_queued -= static_cast<unsigned>(submitted);
+    } else if (errno != EAGAIN && errno != EBUSY && errno != EINTR) {
+      throw callable_exception{ std::string{ "io_uring_enter failed: " } + std::strerror(errno) };
+    }
+  }
+  size_t ran = 0;
+  for (auto tail = ring_load(m_cq_tail); head != tail; tail = ring_load(m_cq_tail)) {
+    auto& completion = static_cast<io_uring_cqe*>(m_cqes)[head & m_cq_mask];
+    auto done = reinterpret_cast<slot*>(completion.user_data);
+    auto result = completion.res;
+    // hand the entry back before the handler runs, it may queue more operations
+    ring_store(m_cq_head, ++head);
+    // the slot goes back even if the handler throws, or the destructor would wait for it forever
+    try {
+      done->handler(result);
+    } catch (...) {
+      release(done);
+      throw;
+    }
+    release(done);
+    ++ran;
+  }
+  return ran;
+#else
+  (void)wait;
+  return 0;
+#endif
+}
+
+template<size_t Capacity>
+size_t
+proactor<Capacity>::run_emulated(bool wait)
+{
+  submit();
+  if (wait && m_in_flight != 0) {
+    // a worker pushes before it counts, so a completion after the check changes the word and ends the wait
+    for (auto seen = m_completions.load(std::memory_order_acquire);
+         m_completed.load(std::memory_order_acquire) == nullptr;
+         seen = m_completions.load(std::memory_order_acquire)) {
+      futex_wait(m_completions, seen);
+    }
+  }
+  // the stack holds the newest completion first
+  slot* oldest = nullptr;
+  for (auto done = m_completed.exchange(nullptr, std::memory_order_acquire); done != nullptr;) {
+    auto next = done->next;
+    done->next = oldest;
+    oldest = done;
+    done = next;
+  }
+  size_t ran = 0;
+  while (oldest != nullptr) {
+    auto done = oldest;
+    oldest = done->next;
+    try {
+      done->handler(done->result);
+    } catch (...) {
+      release(done);
+      requeue(oldest);
+      throw;
+    }
+    release(done);
+    ++ran;
+  }
+  return ran;
+}
+
+template<size_t Capacity>
+void
+proactor<Capacity>::requeue(slot* oldest) noexcept
+{
+  if (oldest == nullptr) {
+    return;
+  }
+  // the stack holds the newest completion first, so the list is reversed on top of it. completions the workers
+  // pushed in the meantime end up below it and run first
+  auto last = oldest;
+  slot* newest = nullptr;
+  while (oldest != nullptr) {
+    auto next = oldest->next;
+    oldest->next = newest;
+    newest = oldest;
+    oldest = next;
+  }
+  auto head = m_completed.load(std::memory_order_relaxed);
+  do {
+    last->next = head;
+  } while (!m_completed.compare_exchange_weak(head, newest, std::memory_order_release, std::memory_order_relaxed));
+}
+}
+
+#undef TMF_PROACTOR_IO_URING
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "callable.hpp"
+#include "mpmc_queue.hpp"
+
+#if defined(__linux__)
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <sys/epoll.h>
+
+namespace tmf {
+
+// a minimal edge-triggered epoll event loop. the read, write and error handlers of every descriptor are held inline
+// in a flat array indexed by the descriptor, so dispatching an event is an index and an indirect call. other
+// threads hand it tasks through a bounded queue and an eventfd. nothing is allocated once it is constructed.
+// `run_once` and `run` are for one thread, `post` and `stop` for any
+template<size_t Capacity = default_callable_capacity, size_t Posts = 1024>
+class reactor
+{
+public:
+  using handler_type = callable<void(int, std::uint32_t), Capacity>;
+  using task_type = callable<void(), Capacity>;
+
+  // events retrieved per `epoll_wait`
+  static constexpr size_t batch = 64;
+
+  // room for descriptors below `descriptors`
+  explicit reactor(size_t descriptors);
+
+  reactor(const reactor&) = delete;
+
+  reactor& operator=(const reactor&) = delete;
+
+  ~reactor();
+
+  // watch `fd`, calling `on_read` when it becomes readable, `on_write` when it becomes writable and `on_error` on
+  // errors and hang ups, each with the descriptor and the epoll events. empty handlers are not watched for. since
+  // readiness is edge triggered, handlers must read or write until the descriptor would block. throws if `fd` does
+  // not fit or epoll refuses it
+  void add(int fd, handler_type on_read, handler_type on_write = {}, handler_type on_error = {});
+
+  // stop watching `fd` and drop its handlers, also from within one of them. a running handler is destroyed once
+  // it returns
+  void remove(int fd);
+
+  // run a task built from `sources`, taking any sources a `callable` can be constructed with, on the thread running
+  // the loop. returns false if the queue of posted tasks is full
+  template<typename... SourceTs>
+  bool post(SourceTs&&... sources);
+
+  // wait up to `timeout_milliseconds` (-1 waits for ever) for at least one event, dispatch everything ready and
+  // return how many handlers and tasks ran
+  size_t run_once(int timeout_milliseconds = -1);
+
+  // dispatch until `stop` is called
+  void run();
+
+  void stop();
+
+  bool stopped() const noexcept;
+
+  // descriptors watched, not counting the eventfd
+  size_t watched() const noexcept;
+
+private:
+  struct entry
+  {
+    bool watched = false;
+    // bumped by every `add` and `remove`, so a dispatch can tell whether its handler was replaced
+    unsigned version = 0;
+    handler_type on_read;
+    handler_type on_write;
+    handler_type on_error;
+  };
+
+  // wake the loop, only the first post since it last woke writes to the eventfd
+  void signal();
+
+  // call the handler `which` of `watching` from a local, so that it may remove or replace itself
+  void dispatch(entry& watching, handler_type entry::*which, int fd, std::uint32_t events);
+
+  size_t run_posted();
+
+  std::unique_ptr<entry[]> m_entries;
+  size_t m_descriptors;
+  size_t m_watched;
+  int m_epoll;
+  int m_wake;
+  std::atomic<bool> m_signalled;
+  std::atomic<bool> m_stopped;
+  epoll_event m_events[batch];
+  mpmc_queue<Posts, Capacity> m_posted;
+};
+}
+
+#include "reactor.inl"
+#endif
\ No newline at end of file
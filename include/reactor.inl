@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace tmf {
+
+template<size_t Capacity, size_t Posts>
+reactor<Capacity, Posts>::reactor(size_t descriptors)
+  : m_entries(new entry[descriptors])
+  , m_descriptors(descriptors)
+  , m_watched(0)
+  , m_epoll(::epoll_create1(EPOLL_CLOEXEC))
+  , m_wake(-1)
+  , m_signalled(false)
+  , m_stopped(false)
+{
+  if (m_epoll == -1) {
+    throw callable_exception{ std::string{ "epoll_create1 failed: " } + std::strerror(errno) };
+  }
+  m_wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_wake == -1) {
+    auto error = errno;
+    ::close(m_epoll);
+    throw callable_exception{ std::string{ "eventfd failed: " } + std::strerror(error) };
+  }
+  epoll_event wake{};
+  wake.events = EPOLLIN | EPOLLET;
+  wake.data.fd = m_wake;
+  if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &wake) == -1) {
+    auto error = errno;
+    ::close(m_wake);
+    ::close(m_epoll);
+    throw callable_exception{ std::string{ "epoll_ctl failed: " } + std::strerror(error) };
+  }
+}
+
+template<size_t Capacity, size_t Posts>
+reactor<Capacity, Posts>::~reactor()
+{
+  ::close(m_wake);
+  ::close(m_epoll);
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::add(int fd, handler_type on_read, handler_type on_write, handler_type on_error)
+{
+  if (fd < 0 || static_cast<size_t>(fd) >= m_descriptors || fd == m_wake) {
+    throw callable_exception{ "the descriptor does not fit in the reactor." };
+  }
+  auto& watching = m_entries[fd];
+  epoll_event interest{};
+  interest.events = EPOLLET | EPOLLRDHUP;
+  interest.events |= on_read.empty() ? 0u : static_cast<std::uint32_t>(EPOLLIN);
+  interest.events |= on_write.empty() ? 0u : static_cast<std::uint32_t>(EPOLLOUT);
+  interest.data.fd = fd;
+  if (::epoll_ctl(m_epoll, watching.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &interest) == -1) {
+    throw callable_exception{ std::string{ "epoll_ctl failed: " } + std::strerror(errno) };
+  }
+  m_watched += watching.watched ? 0 : 1;
+  watching.watched = true;
+  ++watching.version;
+  watching.on_read = std::move(on_read);
+  watching.on_write = std::move(on_write);
+  watching.on_error = std::move(on_error);
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::remove(int fd)
+{
+  if (fd < 0 || static_cast<size_t>(fd) >= m_descriptors || !m_entries[fd].watched) {
+    return;
+  }
+  auto& watching = m_entries[fd];
+  // the descriptor may already be closed, which took it out of the epoll set
+  ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+  --m_watched;
+  watching.watched = false;
+  ++watching.version;
+  // a running handler was moved out of the entry by `dispatch`, this does not destroy it
+  watching.on_read = handler_type{};
+  watching.on_write = handler_type{};
+  watching.on_error = handler_type{};
+}
+
+template<size_t Capacity, size_t Posts>
+template<typename... SourceTs>
+bool
+reactor<Capacity, Posts>::post(SourceTs&&... sources)
+{
+  if (!m_posted.try_emplace(std::forward<SourceTs>(sources)...)) {
+    return false;
+  }
+  signal();
+  return true;
+}
+
+template<size_t Capacity, size_t Posts>
+size_t
+reactor<Capacity, Posts>::run_once(int timeout_milliseconds)
+{
+  auto ready = ::epoll_wait(m_epoll, m_events, static_cast<int>(batch), timeout_milliseconds);
+  if (ready == -1) {
+    if (errno == EINTR) {
+      return 0;
+    }
+    throw callable_exception{ std::string{ "epoll_wait failed: " } + std::strerror(errno) };
+  }
+  size_t ran = 0;
+  for (int index = 0; index < ready; ++index) {
+    auto fd = m_events[index].data.fd;
+    auto events = m_events[index].events;
+    if (fd == m_wake) {
+      ran += run_posted();
+      continue;
+    }
+    // each check sees handlers removed by an earlier event of the batch
+    auto& watching = m_entries[fd];
+    if ((events & (EPOLLIN | EPOLLRDHUP)) != 0 && watching.watched && !watching.on_read.empty()) {
+      dispatch(watching, &entry::on_read, fd, events);
+      ++ran;
+    }
+    if ((events & EPOLLOUT) != 0 && watching.watched && !watching.on_write.empty()) {
+      dispatch(watching, &entry::on_write, fd, events);
+      ++ran;
+    }
+    if ((events & (EPOLLERR | EPOLLHUP)) != 0 && watching.watched && !watching.on_error.empty()) {
+      dispatch(watching, &entry::on_error, fd, events);
+      ++ran;
+    }
+  }
+  return ran;
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::run()
+{
+  while (!m_stopped.load(std::memory_order_acquire)) {
+    run_once();
+  }
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::stop()
+{
+  m_stopped.store(true, std::memory_order_release);
+  // the eventfd may be signalled already, in which case the loop wakes up anyway
+  signal();
+}
+
+template<size_t Capacity, size_t Posts>
+bool
+reactor<Capacity, Posts>::stopped() const noexcept
+{
+  return m_stopped.load(std::memory_order_acquire);
+}
+
+template<size_t Capacity, size_t Posts>
+size_t
+reactor<Capacity, Posts>::watched() const noexcept
+{
+  return m_watched;
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::signal()
+{
+  if (m_signalled.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  std::uint64_t one = 1;
+  // the counter only overflows after 2^64 - 2 unread posts, a failed write would mean the loop is awake anyway
+  (void)!::write(m_wake, &one, sizeof(one));
+}
+
+template<size_t Capacity, size_t Posts>
+void
+reactor<Capacity, Posts>::dispatch(entry& watching, handler_type entry::*which, int fd, std::uint32_t events)
+{
+  // the handler goes back into its entry on the way out, also when it throws, unless it removed or replaced the
+  // handlers of its descriptor meanwhile. otherwise it is destroyed here, after it returned
+  struct running
+  {
+    ~running()
+    {
+      if (watching.version == version) {
+        watching.*which = std::move(handler);
+      }
+    }
+
+    entry& watching;
+    handler_type entry::*which;
+    unsigned version;
+    handler_type handler;
+  } call{ watching, which, watching.version, std::move(watching.*which) };
+  call.handler(fd, events);
+}
+
+template<size_t Capacity, size_t Posts>
+size_t
+reactor<Capacity, Posts>::run_posted()
+{
+  std::uint64_t count = 0;
+  (void)!::read(m_wake, &count, sizeof(count));
+  // posts from here on signal again, and the exchange makes every post that found the flag set visible to the
+  // drain below, so none of them can be left behind
+  m_signalled.exchange(false, std::memory_order_acq_rel);
+  size_t ran = 0;
+  task_type task;
+  while (m_posted.try_pop(task)) {
+    task();
+    ++ran;
+  }
+  return ran;
+}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+
+namespace tmf {
+
+inline namespace detail {
+
+// a lock free list of every `DerivedT` that `of` created, newest first. entries are constructed from `ArgTs`, live in
+// function local statics and are never removed, so the list can be walked while other threads register. objects
+// constructed directly are not registered
+template<typename DerivedT, typename... ArgTs>
+class registry
+{
+public:
+  registry(const registry&) = delete;
+
+  registry& operator=(const registry&) = delete;
+
+  // the entry of `KeyT`, constructed from `arguments` and registered on first use
+  template<typename KeyT>
+  static DerivedT& of(ArgTs... arguments) noexcept;
+
+  // the first registered entry, the rest follow through `next`
+  static const DerivedT* first() noexcept;
+
+  // `clear` every registered entry
+  static void reset() noexcept;
+
+  DerivedT* next = nullptr;
+
+protected:
+  registry() noexcept = default;
+
+private:
+  struct entry;
+
+  static std::atomic<DerivedT*>& head() noexcept;
+};
+}
+}
+
+#include "registry.inl"
\ No newline at end of file
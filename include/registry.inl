@@ -0,0 +1,55 @@
+#pragma once
+
+namespace tmf {
+
+inline namespace detail {
+
+// registers itself once `DerivedT` is fully constructed, so no reader ever sees it half built
+template<typename DerivedT, typename... ArgTs>
+struct registry<DerivedT, ArgTs...>::entry : DerivedT
+{
+  explicit entry(ArgTs... arguments) noexcept
+    : DerivedT(arguments...)
+  {
+    auto& list = head();
+    auto top = list.load(std::memory_order_relaxed);
+    do {
+      this->next = top;
+    } while (!list.compare_exchange_weak(top, this, std::memory_order_release, std::memory_order_relaxed));
+  }
+};
+
+template<typename DerivedT, typename... ArgTs>
+template<typename KeyT>
+DerivedT&
+registry<DerivedT, ArgTs...>::of(ArgTs... arguments) noexcept
+{
+  static entry instance{ arguments... };
+  return instance;
+}
+
+template<typename DerivedT, typename... ArgTs>
+const DerivedT*
+registry<DerivedT, ArgTs...>::first() noexcept
+{
+  return head().load(std::memory_order_acquire);
+}
+
+template<typename DerivedT, typename... ArgTs>
+void
+registry<DerivedT, ArgTs...>::reset() noexcept
+{
+  for (auto current = head().load(std::memory_order_acquire); current != nullptr; current = current->next) {
+    current->clear();
+  }
+}
+
+template<typename DerivedT, typename... ArgTs>
+std::atomic<DerivedT*>&
+registry<DerivedT, ArgTs...>::head() noexcept
+{
+  static std::atomic<DerivedT*> list{ nullptr };
+  return list;
+}
+}
+}
\ No newline at end of file
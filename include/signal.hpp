@@ -0,0 +1,92 @@
+#pragma once
+
+#include "callable.hpp"
+#include "epoch_domain.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace tmf {
+
+template<typename, size_t = default_callable_capacity>
+struct signal;
+
+// a multicast delegate: every subscribed slot is called on emission. emitting is wait-free and never locks or
+// allocates, it walks the slot table under an epoch guard while subscribers are added and removed concurrently.
+// slots are called in the order of the table, which reuses the places of unsubscribed slots
+template<typename... ArgTs, size_t Capacity>
+struct signal<void(ArgTs...), Capacity>
+{
+  using slot_type = callable<void(ArgTs...), Capacity>;
+  using this_type = signal<void(ArgTs...), Capacity>;
+
+  // identifies a subscription, stays harmless to unsubscribe after its slot is reused
+  struct connection
+  {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+  };
+
+  signal() noexcept;
+
+  signal(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // there must be no emission in progress
+  ~signal();
+
+  // subscribe a slot built from `sources`, taking any sources a `callable` can be constructed with
+  template<typename... SourceTs>
+  connection subscribe(SourceTs&&... sources);
+
+  // stop calling the slot for `subscription`; an emission already underway may still call it once.
+  // returns false if the subscription had already ended
+  bool unsubscribe(connection subscription);
+
+  // call every subscribed slot, rvalue reference arguments are passed on to each slot in turn
+  void emit(ArgTs... arguments) const;
+
+  // same as `emit`
+  void operator()(ArgTs... arguments) const;
+
+  // subscribed slots
+  size_t size() const;
+
+  bool empty() const;
+
+private:
+  static constexpr size_t slots_per_block = 32;
+
+  struct slot
+  {
+    std::uint32_t generation = 0;
+    slot_type target;
+  };
+
+  // blocks are only ever appended, emission follows `next` without holding the writer lock and calls the slots
+  // whose bit is set in `live`
+  struct block
+  {
+    std::atomic<std::uint32_t> live{ 0 };
+    std::atomic<block*> next{ nullptr };
+    slot slots[slots_per_block];
+  };
+
+  static std::uint32_t live_bit(std::uint32_t index);
+
+  slot& at(std::uint32_t index);
+
+  std::atomic<block*> m_head;
+  std::atomic<size_t> m_size;
+  std::mutex m_writer;
+  // writer side bookkeeping, guarded by `m_writer`
+  std::vector<block*> m_blocks;
+  std::vector<std::uint32_t> m_free;
+  epoch_domain m_domain;
+};
+}
+
+#include "signal.inl"
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+namespace tmf {
+
+inline namespace detail {
+
+inline unsigned
+lowest_set_bit(std::uint32_t mask)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+  unsigned index = 0;
+  for (; (mask & 1) == 0; mask >>= 1) {
+    ++index;
+  }
+  return index;
+#endif
+}
+
+} // namespace detail
+
+template<typename... ArgTs, size_t Capacity>
+signal<void(ArgTs...), Capacity>::signal() noexcept
+  : m_head(nullptr)
+  , m_size(0)
+{}
+
+template<typename... ArgTs, size_t Capacity>
+signal<void(ArgTs...), Capacity>::~signal()
+{
+  m_domain.synchronize();
+  for (auto stored_block : m_blocks) {
+    delete stored_block;
+  }
+}
+
+template<typename... ArgTs, size_t Capacity>
+template<typename... SourceTs>
+typename signal<void(ArgTs...), Capacity>::connection
+signal<void(ArgTs...), Capacity>::subscribe(SourceTs&&... sources)
+{
+  slot_type target{ std::forward<SourceTs>(sources)... };
+  std::lock_guard<std::mutex> lock{ m_writer };
+  m_domain.collect();
+  if (m_free.empty()) {
+    auto appended = new block{};
+    auto first_index = static_cast<std::uint32_t>(m_blocks.size() * slots_per_block);
+    for (auto index = static_cast<std::uint32_t>(slots_per_block); index > 0; --index) {
+      m_free.push_back(first_index + index - 1);
+    }
+    if (m_blocks.empty()) {
+      m_head.store(appended, std::memory_order_release);
+    } else {
+      m_blocks.back()->next.store(appended, std::memory_order_release);
+    }
+    m_blocks.push_back(appended);
+  }
+  auto index = m_free.back();
+  m_free.pop_back();
+  auto& reused = at(index);
+  // nobody reads a slot that isn't live, so it can be written before being published
+  reused.target = std::move(target);
+  m_blocks[index / slots_per_block]->live.fetch_or(live_bit(index), std::memory_order_release);
+  m_size.fetch_add(1, std::memory_order_relaxed);
+  return connection{ index, reused.generation };
+}
+
+template<typename... ArgTs, size_t Capacity>
+bool
+signal<void(ArgTs...), Capacity>::unsubscribe(connection subscription)
+{
+  std::lock_guard<std::mutex> lock{ m_writer };
+  if (subscription.index >= m_blocks.size() * slots_per_block) {
+    return false;
+  }
+  auto& ended = at(subscription.index);
+  auto& live = m_blocks[subscription.index / slots_per_block]->live;
+  if (ended.generation != subscription.generation ||
+      (live.load(std::memory_order_relaxed) & live_bit(subscription.index)) == 0) {
+    return false;
+  }
+  live.fetch_and(~live_bit(subscription.index), std::memory_order_release);
+  ++ended.generation;
+  m_size.fetch_sub(1, std::memory_order_relaxed);
+  // emissions that saw the slot live may still be calling it, it is cleared and reused once they are done
+  m_domain.retire([this, index = subscription.index] {
+    at(index).target = slot_type{};
+    m_free.push_back(index);
+  });
+  m_domain.collect();
+  return true;
+}
+
+template<typename... ArgTs, size_t Capacity>
+void
+signal<void(ArgTs...), Capacity>::emit(ArgTs... arguments) const
+{
+  auto reading = m_domain.enter();
+  for (auto current = m_head.load(std::memory_order_acquire); current != nullptr;
+       current = current->next.load(std::memory_order_acquire)) {
+    for (auto live = current->live.load(std::memory_order_acquire); live != 0; live &= live - 1) {
+      current->slots[lowest_set_bit(live)].target(static_cast<ArgTs>(arguments)...);
+    }
+  }
+}
+
+template<typename... ArgTs, size_t Capacity>
+void
+signal<void(ArgTs...), Capacity>::operator()(ArgTs... arguments) const
+{
+  emit(static_cast<ArgTs>(arguments)...);
+}
+
+template<typename... ArgTs, size_t Capacity>
+size_t
+signal<void(ArgTs...), Capacity>::size() const
+{
+  return m_size.load(std::memory_order_relaxed);
+}
+
+template<typename... ArgTs, size_t Capacity>
+bool
+signal<void(ArgTs...), Capacity>::empty() const
+{
+  return size() == 0;
+}
+
+template<typename... ArgTs, size_t Capacity>
+std::uint32_t
+signal<void(ArgTs...), Capacity>::live_bit(std::uint32_t index)
+{
+  return std::uint32_t{ 1 } << (index % slots_per_block);
+}
+
+template<typename... ArgTs, size_t Capacity>
+typename signal<void(ArgTs...), Capacity>::slot&
+signal<void(ArgTs...), Capacity>::at(std::uint32_t index)
+{
+  return m_blocks[index / slots_per_block]->slots[index % slots_per_block];
+}
+}
\ No newline at end of file
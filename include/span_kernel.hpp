@@ -0,0 +1,48 @@
+#pragma once
+
+#include "callable.hpp"
+
+#if defined(__cpp_lib_span)
+
+namespace tmf {
+
+template<typename, size_t = default_callable_capacity>
+struct span_kernel;
+
+// lifts a scalar callable to a loop over spans. the loop is instantiated for the concrete source when it is
+// bound, so running the kernel costs one type-erased call per span instead of one per element
+template<typename ReturnT, typename ArgT, size_t Capacity>
+struct span_kernel<ReturnT(ArgT), Capacity>
+{
+  using scalar_type = callable<ReturnT(ArgT), Capacity>;
+  using input_type = std::span<batch_column_t<ArgT>>;
+  using output_type = std::span<batch_result_t<ReturnT>>;
+  using kernel_type = void(input_type, output_type);
+  using this_type = span_kernel<ReturnT(ArgT), Capacity>;
+
+  static_assert(!std::is_void_v<ReturnT>, "a span kernel writes one output per input");
+
+  // binds a source the same ways a `callable` can
+  template<typename SourceT, typename = std::enable_if_t<!std::is_same_v<std::decay_t<SourceT>, this_type>>>
+  span_kernel(SourceT&& source) noexcept;
+
+  // binds an { object, member } pair the same ways a `callable` can
+  template<typename ClassT, typename MemPtrT>
+  span_kernel(ClassT&& object, MemPtrT member) noexcept;
+
+  // call the scalar source for every element of `input`, writing to the matching element of `output`
+  void operator()(input_type input, output_type output) const;
+
+  // call the scalar source for a single element
+  ReturnT operator()(ArgT argument) const;
+
+  const scalar_type& scalar() const;
+
+private:
+  scalar_type m_scalar;
+};
+}
+
+#include "span_kernel.inl"
+
+#endif
\ No newline at end of file
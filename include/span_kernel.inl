@@ -0,0 +1,40 @@
+#pragma once
+
+namespace tmf {
+
+template<typename ReturnT, typename ArgT, size_t Capacity>
+template<typename SourceT, typename>
+span_kernel<ReturnT(ArgT), Capacity>::span_kernel(SourceT&& source) noexcept
+  : m_scalar(std::forward<SourceT>(source))
+{}
+
+template<typename ReturnT, typename ArgT, size_t Capacity>
+template<typename ClassT, typename MemPtrT>
+span_kernel<ReturnT(ArgT), Capacity>::span_kernel(ClassT&& object, MemPtrT member) noexcept
+  : m_scalar(std::forward<ClassT>(object), member)
+{}
+
+template<typename ReturnT, typename ArgT, size_t Capacity>
+void
+span_kernel<ReturnT(ArgT), Capacity>::operator()(input_type input, output_type output) const
+{
+  if (output.size() < input.size()) {
+    throw callable_exception{ "span kernel output is shorter than its input." };
+  }
+  m_scalar.invoke_batch(input, output);
+}
+
+template<typename ReturnT, typename ArgT, size_t Capacity>
+ReturnT
+span_kernel<ReturnT(ArgT), Capacity>::operator()(ArgT argument) const
+{
+  return m_scalar(static_cast<ArgT>(argument));
+}
+
+template<typename ReturnT, typename ArgT, size_t Capacity>
+const callable<ReturnT(ArgT), Capacity>&
+span_kernel<ReturnT(ArgT), Capacity>::scalar() const
+{
+  return m_scalar;
+}
+}
\ No newline at end of file
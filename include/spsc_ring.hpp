@@ -0,0 +1,111 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace tmf {
+
+inline namespace detail {
+
+// calls a source pushed into a `spsc_ring`: invocables directly, pointers and shared pointers to functors through
+// the pointer
+template<typename SourceT>
+void
+invoke_source(SourceT& source)
+{
+  if constexpr (std::is_invocable_v<SourceT&>) {
+    std::invoke(source);
+  } else {
+    (*source)();
+  }
+}
+
+template<typename ObjectT, typename MemPtrT>
+struct bound_member
+{
+  void operator()() { std::invoke(m_member, m_object); }
+
+  ObjectT m_object;
+  MemPtrT m_member;
+};
+
+} // namespace detail
+
+// a single-producer/single-consumer ring of `void()` tasks packed back to back in `Bytes` bytes. an entry is a
+// header (dispatch pointer and entry size) followed by exactly the bytes of the stored source, rounded up to
+// `entry_alignment`, so small tasks take a fraction of a cache line. `Bytes` must be a power of two
+template<size_t Bytes>
+struct spsc_ring
+{
+  static_assert(Bytes >= 64 && (Bytes & (Bytes - 1)) == 0, "`tmf::spsc_ring` size must be a power of two");
+
+  using this_type = spsc_ring<Bytes>;
+
+  static constexpr size_t entry_alignment = alignof(std::uint64_t);
+
+  spsc_ring() noexcept;
+
+  spsc_ring(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // destroys the tasks that were never run
+  ~spsc_ring();
+
+  // producer: copy or move a lambda, functor, function pointer, functor pointer or functor `std::shared_ptr` into
+  // the ring, unless there is not enough room
+  template<typename SourceT>
+  bool try_push(SourceT&& source);
+
+  // producer: store an { object, member } pair, the object may be a value, pointer or `std::shared_ptr`
+  template<typename ObjectT, typename MemPtrT>
+  bool try_push(ObjectT&& object, MemPtrT member);
+
+  // consumer: run and destroy the oldest task, unless the ring is empty
+  bool try_pop();
+
+  // consumer: run and destroy up to `limit` tasks in order, publishing the freed space once at the end.
+  // returns how many ran
+  size_t drain(size_t limit = static_cast<size_t>(-1));
+
+  // bytes an entry for a source of type `SourceT` takes, header included
+  template<typename SourceT>
+  static constexpr size_t entry_size() noexcept;
+
+  bool empty() const noexcept;
+
+  static constexpr size_t size() noexcept { return Bytes; }
+
+private:
+  // destroys the payload, running it first if `run` is set
+  using dispatch_function_pointer = void (*)(void*, bool);
+
+  struct header
+  {
+    // null for padding that skips to the end of the buffer
+    dispatch_function_pointer dispatch;
+    std::uint32_t size;
+  };
+
+  static constexpr size_t round_up(size_t size) noexcept;
+
+  template<typename StoredT, typename... ArgTs>
+  bool emplace(ArgTs&&... arguments);
+
+  // runs the entry at `position`, returns where the next one starts; wraps over padding without running anything
+  size_t consume(size_t position, bool run);
+
+  // producer side: its position, and the last consumer position it has seen
+  alignas(64) std::atomic<size_t> m_head;
+  size_t m_cached_tail;
+  // consumer side: its position, and the last producer position it has seen
+  alignas(64) std::atomic<size_t> m_tail;
+  size_t m_cached_head;
+  alignas(64) unsigned char m_buffer[Bytes];
+};
+}
+
+#include "spsc_ring.inl"
\ No newline at end of file
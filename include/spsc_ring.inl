@@ -0,0 +1,164 @@
+#pragma once
+
+#include <new>
+
+namespace tmf {
+
+template<size_t Bytes>
+spsc_ring<Bytes>::spsc_ring() noexcept
+  : m_head(0)
+  , m_cached_tail(0)
+  , m_tail(0)
+  , m_cached_head(0)
+{}
+
+template<size_t Bytes>
+spsc_ring<Bytes>::~spsc_ring()
+{
+  auto position = m_tail.load(std::memory_order_relaxed);
+  auto end = m_head.load(std::memory_order_acquire);
+  while (position != end) {
+    position = consume(position, false);
+  }
+}
+
+template<size_t Bytes>
+template<typename SourceT>
+bool
+spsc_ring<Bytes>::try_push(SourceT&& source)
+{
+  using stored_type = std::decay_t<SourceT>;
+  return emplace<stored_type>(std::forward<SourceT>(source));
+}
+
+template<size_t Bytes>
+template<typename ObjectT, typename MemPtrT>
+bool
+spsc_ring<Bytes>::try_push(ObjectT&& object, MemPtrT member)
+{
+  using stored_type = bound_member<std::decay_t<ObjectT>, MemPtrT>;
+  return emplace<stored_type>(stored_type{ std::forward<ObjectT>(object), member });
+}
+
+template<size_t Bytes>
+bool
+spsc_ring<Bytes>::try_pop()
+{
+  return drain(1) == 1;
+}
+
+template<size_t Bytes>
+size_t
+spsc_ring<Bytes>::drain(size_t limit)
+{
+  auto position = m_tail.load(std::memory_order_relaxed);
+  size_t ran = 0;
+  // the consumer position is published even if a task throws. it is moved past each entry before the entry runs,
+  // so a task that throws (and is destroyed by its dispatch on the way out) is never reached again
+  struct publish
+  {
+    ~publish() { tail.store(position, std::memory_order_release); }
+    std::atomic<size_t>& tail;
+    size_t& position;
+  } published{ m_tail, position };
+  while (ran < limit) {
+    if (position == m_cached_head) {
+      m_cached_head = m_head.load(std::memory_order_acquire);
+      if (position == m_cached_head) {
+        break;
+      }
+    }
+    auto offset = position & (Bytes - 1);
+    auto entry = reinterpret_cast<header*>(m_buffer + offset);
+    if (Bytes - offset < sizeof(header) || entry->dispatch == nullptr) {
+      position = consume(position, false);
+      continue;
+    }
+    position += entry->size;
+    entry->dispatch(m_buffer + offset + sizeof(header), true);
+    ++ran;
+  }
+  return ran;
+}
+
+template<size_t Bytes>
+template<typename SourceT>
+constexpr size_t
+spsc_ring<Bytes>::entry_size() noexcept
+{
+  return sizeof(header) + round_up(sizeof(SourceT));
+}
+
+template<size_t Bytes>
+bool
+spsc_ring<Bytes>::empty() const noexcept
+{
+  return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+}
+
+template<size_t Bytes>
+constexpr size_t
+spsc_ring<Bytes>::round_up(size_t size) noexcept
+{
+  return (size + entry_alignment - 1) & ~(entry_alignment - 1);
+}
+
+template<size_t Bytes>
+template<typename StoredT, typename... ArgTs>
+bool
+spsc_ring<Bytes>::emplace(ArgTs&&... arguments)
+{
+  static_assert(alignof(StoredT) <= entry_alignment, "`tmf::spsc_ring` cannot hold over-aligned sources");
+  static_assert(sizeof(header) % entry_alignment == 0);
+  constexpr size_t needed = entry_size<StoredT>();
+  static_assert(needed <= Bytes, "`tmf::spsc_ring` cannot hold a source this large");
+  auto position = m_head.load(std::memory_order_relaxed);
+  auto offset = position & (Bytes - 1);
+  // entries never straddle the end of the buffer, the rest of it is skipped instead
+  size_t skipped = Bytes - offset < needed ? Bytes - offset : 0;
+  if (Bytes - (position - m_cached_tail) < skipped + needed) {
+    m_cached_tail = m_tail.load(std::memory_order_acquire);
+    if (Bytes - (position - m_cached_tail) < skipped + needed) {
+      return false;
+    }
+  }
+  if (skipped != 0) {
+    if (skipped >= sizeof(header)) {
+      new (m_buffer + offset) header{ nullptr, static_cast<std::uint32_t>(skipped) };
+    }
+    position += skipped;
+    offset = 0;
+  }
+  new (m_buffer + offset + sizeof(header)) StoredT(std::forward<ArgTs>(arguments)...);
+  new (m_buffer + offset) header{ [](void* payload, bool run) {
+                                   auto stored = std::launder(static_cast<StoredT*>(payload));
+                                   struct destroy
+                                   {
+                                     ~destroy() { stored->~StoredT(); }
+                                     StoredT* stored;
+                                   } destroyed{ stored };
+                                   if (run) {
+                                     invoke_source(*stored);
+                                   }
+                                 },
+                                  static_cast<std::uint32_t>(needed) };
+  m_head.store(position + needed, std::memory_order_release);
+  return true;
+}
+
+template<size_t Bytes>
+size_t
+spsc_ring<Bytes>::consume(size_t position, bool run)
+{
+  auto offset = position & (Bytes - 1);
+  if (Bytes - offset < sizeof(header)) {
+    return position + (Bytes - offset);
+  }
+  auto entry = reinterpret_cast<header*>(m_buffer + offset);
+  auto next = position + entry->size;
+  if (entry->dispatch != nullptr) {
+    entry->dispatch(m_buffer + offset + sizeof(header), run);
+  }
+  return next;
+}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "callable.hpp"
+#include "frame_pool.hpp"
+
+#include <atomic>
+
+namespace tmf {
+
+// runs tasks one at a time and in the order they were posted, on the threads of `ExecutorT`, without a lock or a
+// thread of its own. tasks wait in a lock-free intrusive queue whose nodes come from the `frame_pool`. the strand
+// posts itself to the executor only when its queue goes from empty to non-empty, then runs up to `batch` tasks
+// per turn before yielding the thread. `ExecutorT` must have a `post` taking a callable, as `thread_pool` does.
+// tasks must not throw and the strand must outlive them
+template<typename ExecutorT, size_t Capacity = default_callable_capacity>
+class strand
+{
+public:
+  using task_type = callable<void(), Capacity>;
+
+  explicit strand(ExecutorT& executor, size_t batch = 64) noexcept;
+
+  strand(const strand&) = delete;
+
+  strand& operator=(const strand&) = delete;
+
+  // waits for the executor thread that ran the last task to let go of the strand, there must be no task left
+  ~strand();
+
+  // queue a task built from `sources`, taking any sources a `callable` can be constructed with
+  template<typename... SourceTs>
+  void post(SourceTs&&... sources);
+
+  // check if the calling thread is running a task of this strand
+  bool running_in_this_thread() const noexcept;
+
+  ExecutorT& executor() const noexcept;
+
+private:
+  struct node
+  {
+    std::atomic<node*> next{ nullptr };
+    task_type task;
+  };
+
+  // producers only ever touch the tail, the one thread draining the strand owns the head
+  void push(node* pushed) noexcept;
+
+  node* pop() noexcept;
+
+  // run queued tasks on the executor thread, handing the strand back to the executor if more remain
+  void drain() noexcept;
+
+  static const strand*& current() noexcept;
+
+  ExecutorT& m_executor;
+  size_t m_batch;
+  node m_stub;
+  node* m_head;
+  alignas(64) std::atomic<node*> m_tail;
+  alignas(64) std::atomic<size_t> m_pending;
+};
+}
+
+#include "strand.inl"
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <new>
+#include <thread>
+
+namespace tmf {
+
+template<typename ExecutorT, size_t Capacity>
+strand<ExecutorT, Capacity>::strand(ExecutorT& executor, size_t batch) noexcept
+  : m_executor(executor)
+  , m_batch(batch == 0 ? 1 : batch)
+  , m_head(&m_stub)
+  , m_tail(&m_stub)
+  , m_pending(0)
+{}
+
+template<typename ExecutorT, size_t Capacity>
+strand<ExecutorT, Capacity>::~strand()
+{
+  // the turn that ran the last task may still be letting go of the count
+  while (m_pending.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+}
+
+template<typename ExecutorT, size_t Capacity>
+template<typename... SourceTs>
+void
+strand<ExecutorT, Capacity>::post(SourceTs&&... sources)
+{
+  auto pushed = new (frame_pool::allocate(sizeof(node))) node{};
+  pushed->task = task_type{ std::forward<SourceTs>(sources)... };
+  push(pushed);
+  // whoever takes the count off zero schedules the strand, everybody else finds it already scheduled
+  if (m_pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
+    m_executor.post([this] { drain(); });
+  }
+}
+
+template<typename ExecutorT, size_t Capacity>
+bool
+strand<ExecutorT, Capacity>::running_in_this_thread() const noexcept
+{
+  return current() == this;
+}
+
+template<typename ExecutorT, size_t Capacity>
+ExecutorT&
+strand<ExecutorT, Capacity>::executor() const noexcept
+{
+  return m_executor;
+}
+
+template<typename ExecutorT, size_t Capacity>
+void
+strand<ExecutorT, Capacity>::push(node* pushed) noexcept
+{
+  pushed->next.store(nullptr, std::memory_order_relaxed);
+  auto previous = m_tail.exchange(pushed, std::memory_order_acq_rel);
+  previous->next.store(pushed, std::memory_order_release);
+}
+
+template<typename ExecutorT, size_t Capacity>
+typename strand<ExecutorT, Capacity>::node*
+strand<ExecutorT, Capacity>::pop() noexcept
+{
+  auto head = m_head;
+  auto next = head->next.load(std::memory_order_acquire);
+  if (head == &m_stub) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    m_head = next;
+    head = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    m_head = next;
+    return head;
+  }
+  if (head != m_tail.load(std::memory_order_acquire)) {
+    // a producer has swapped the tail but not linked its node yet
+    return nullptr;
+  }
+  // the last node cannot leave the queue empty, put the stub behind it first
+  push(&m_stub);
+  next = head->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    m_head = next;
+    return head;
+  }
+  return nullptr;
+}
+
+template<typename ExecutorT, size_t Capacity>
+void
+strand<ExecutorT, Capacity>::drain() noexcept
+{
+  auto& running = current();
+  auto outer = running;
+  running = this;
+  size_t ran = 0;
+  while (ran < m_batch) {
+    auto popped = pop();
+    if (popped == nullptr) {
+      // counted but still being linked by its producer, or nothing left in this turn's share
+      if (m_pending.load(std::memory_order_acquire) == ran) {
+        break;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    popped->task();
+    popped->~node();
+    frame_pool::deallocate(popped, sizeof(node));
+    ++ran;
+  }
+  running = outer;
+  // tasks posted meanwhile did not schedule the strand, as the count never went back to zero
+  if (m_pending.fetch_sub(ran, std::memory_order_acq_rel) != ran) {
+    m_executor.post([this] { drain(); });
+  }
+}
+
+template<typename ExecutorT, size_t Capacity>
+const strand<ExecutorT, Capacity>*&
+strand<ExecutorT, Capacity>::current() noexcept
+{
+  thread_local const strand* running = nullptr;
+  return running;
+}
+}
\ No newline at end of file
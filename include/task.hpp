@@ -0,0 +1,163 @@
+#pragma once
+
+#include "callable.hpp"
+#include "frame_pool.hpp"
+
+#if __has_include(<coroutine>)
+#include <coroutine>
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <optional>
+
+namespace tmf {
+
+template<typename ResultT = void>
+class task;
+
+inline namespace detail {
+
+// the part of a task's promise that does not depend on the result
+class task_promise_base
+{
+public:
+  // where the task stands, moved forward by whichever of the task and the party waiting on it gets there first
+  enum status : uint32_t
+  {
+    running = 0,
+    awaited = 1,
+    finished = 2
+  };
+
+  struct final_awaiter
+  {
+    bool await_ready() const noexcept { return false; }
+
+    template<typename PromiseT>
+    void await_suspend(std::coroutine_handle<PromiseT> handle) noexcept;
+
+    void await_resume() const noexcept {}
+  };
+
+  static void* operator new(size_t bytes);
+
+  static void operator delete(void* frame, size_t bytes) noexcept;
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  final_awaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() noexcept;
+
+  // resume the coroutine from its initial suspension, unless that already happened
+  void start_once(std::coroutine_handle<> handle) noexcept;
+
+  // register `continuation` to run once the task finishes, false when it already has, in which case the caller
+  // carries on by itself
+  bool suspend_until_finished(callable<void()> continuation) noexcept;
+
+  bool is_finished() const noexcept;
+
+protected:
+  void rethrow_if_failed() const;
+
+private:
+  callable<void()> m_continuation;
+  std::exception_ptr m_exception;
+  std::atomic<uint32_t> m_status{ running };
+  bool m_started = false;
+};
+
+template<typename ResultT>
+class task_promise : public task_promise_base
+{
+public:
+  task<ResultT> get_return_object() noexcept;
+
+  template<typename ValueT>
+  void return_value(ValueT&& value);
+
+  ResultT take();
+
+private:
+  std::optional<ResultT> m_value;
+};
+
+template<>
+class task_promise<void> : public task_promise_base
+{
+public:
+  task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void take();
+};
+
+} // namespace detail
+
+// a lazily started coroutine. whoever waits on it registers a `callable<void()>` continuation, either a `co_await`
+// resuming its own coroutine or a completion callback passed to `start`, and frames come from the `frame_pool`.
+// awaiting a task that has already finished carries on without suspending. a task is awaited or started once
+template<typename ResultT>
+class task
+{
+public:
+  using promise_type = task_promise<ResultT>;
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  struct awaiter
+  {
+    bool await_ready() const noexcept;
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+    ResultT await_resume();
+
+    handle_type handle;
+  };
+
+  // a task without a coroutine
+  task() noexcept;
+
+  task(task&& other) noexcept;
+
+  task& operator=(task&& rhs) noexcept;
+
+  task(const task&) = delete;
+
+  task& operator=(const task&) = delete;
+
+  // destroys the coroutine, which must not be running
+  ~task();
+
+  // check if there is a coroutine
+  bool valid() const noexcept;
+
+  // check if the coroutine has returned or thrown
+  bool done() const noexcept;
+
+  // run the coroutine without awaiting it, `on_done` runs on whichever thread finishes it
+  void start(callable<void()> on_done = {});
+
+  // the result of a finished coroutine, or rethrow what it threw
+  ResultT result();
+
+  awaiter operator co_await() const noexcept;
+
+private:
+  friend class task_promise<ResultT>;
+
+  explicit task(handle_type handle) noexcept;
+
+  handle_type m_handle;
+};
+}
+
+#include "task.inl"
+
+#endif
\ No newline at end of file
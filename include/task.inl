@@ -0,0 +1,212 @@
+#pragma once
+
+namespace tmf {
+
+inline namespace detail {
+
+template<typename PromiseT>
+void
+task_promise_base::final_awaiter::await_suspend(std::coroutine_handle<PromiseT> handle) noexcept
+{
+  task_promise_base& promise = handle.promise();
+  // once the exchange has happened the frame may only be touched if somebody is suspended waiting for it, as that
+  // keeps it alive until the continuation has run
+  if (promise.m_status.exchange(finished, std::memory_order_acq_rel) == awaited) {
+    auto continuation = std::move(promise.m_continuation);
+    continuation();
+  }
+}
+
+inline void*
+task_promise_base::operator new(size_t bytes)
+{
+  return frame_pool::allocate(bytes);
+}
+
+inline void
+task_promise_base::operator delete(void* frame, size_t bytes) noexcept
+{
+  frame_pool::deallocate(frame, bytes);
+}
+
+inline void
+task_promise_base::unhandled_exception() noexcept
+{
+  m_exception = std::current_exception();
+}
+
+inline void
+task_promise_base::start_once(std::coroutine_handle<> handle) noexcept
+{
+  if (!m_started) {
+    m_started = true;
+    handle.resume();
+  }
+}
+
+inline bool
+task_promise_base::suspend_until_finished(callable<void()> continuation) noexcept
+{
+  m_continuation = std::move(continuation);
+  auto expected = static_cast<uint32_t>(running);
+  return m_status.compare_exchange_strong(expected, awaited, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+inline bool
+task_promise_base::is_finished() const noexcept
+{
+  return m_status.load(std::memory_order_acquire) == finished;
+}
+
+inline void
+task_promise_base::rethrow_if_failed() const
+{
+  if (m_exception) {
+    std::rethrow_exception(m_exception);
+  }
+}
+
+template<typename ResultT>
+task<ResultT>
+task_promise<ResultT>::get_return_object() noexcept
+{
+  return task<ResultT>{ std::coroutine_handle<task_promise<ResultT>>::from_promise(*this) };
+}
+
+template<typename ResultT>
+template<typename ValueT>
+void
+task_promise<ResultT>::return_value(ValueT&& value)
+{
+  m_value.emplace(std::forward<ValueT>(value));
+}
+
+template<typename ResultT>
+ResultT
+task_promise<ResultT>::take()
+{
+  rethrow_if_failed();
+  return std::move(*m_value);
+}
+
+inline task<void>
+task_promise<void>::get_return_object() noexcept
+{
+  return task<void>{ std::coroutine_handle<task_promise<void>>::from_promise(*this) };
+}
+
+inline void
+task_promise<void>::take()
+{
+  rethrow_if_failed();
+}
+
+} // namespace detail
+
+template<typename ResultT>
+bool
+task<ResultT>::awaiter::await_ready() const noexcept
+{
+  return handle.promise().is_finished();
+}
+
+template<typename ResultT>
+bool
+task<ResultT>::awaiter::await_suspend(std::coroutine_handle<> awaiting) noexcept
+{
+  handle.promise().start_once(handle);
+  return handle.promise().suspend_until_finished([awaiting] { awaiting.resume(); });
+}
+
+template<typename ResultT>
+ResultT
+task<ResultT>::awaiter::await_resume()
+{
+  return handle.promise().take();
+}
+
+template<typename ResultT>
+task<ResultT>::task() noexcept
+  : m_handle(nullptr)
+{}
+
+template<typename ResultT>
+task<ResultT>::task(handle_type handle) noexcept
+  : m_handle(handle)
+{}
+
+template<typename ResultT>
+task<ResultT>::task(task&& other) noexcept
+  : m_handle(other.m_handle)
+{
+  other.m_handle = nullptr;
+}
+
+template<typename ResultT>
+task<ResultT>&
+task<ResultT>::operator=(task&& rhs) noexcept
+{
+  if (this != &rhs) {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+    m_handle = rhs.m_handle;
+    rhs.m_handle = nullptr;
+  }
+  return *this;
+}
+
+template<typename ResultT>
+task<ResultT>::~task()
+{
+  if (m_handle) {
+    m_handle.destroy();
+  }
+}
+
+template<typename ResultT>
+bool
+task<ResultT>::valid() const noexcept
+{
+  return static_cast<bool>(m_handle);
+}
+
+template<typename ResultT>
+bool
+task<ResultT>::done() const noexcept
+{
+  return m_handle && m_handle.promise().is_finished();
+}
+
+template<typename ResultT>
+void
+task<ResultT>::start(callable<void()> on_done)
+{
+  if (!m_handle) {
+    throw callable_exception{ "attempted to start a task without a coroutine." };
+  }
+  auto& promise = m_handle.promise();
+  promise.start_once(m_handle);
+  // copied from a const reference, a mutable one would be wrapped as a functor
+  if (!on_done.empty() && !promise.suspend_until_finished(std::as_const(on_done))) {
+    on_done();
+  }
+}
+
+template<typename ResultT>
+ResultT
+task<ResultT>::result()
+{
+  if (!done()) {
+    throw callable_exception{ "attempted to take the result of a task that has not finished." };
+  }
+  return m_handle.promise().take();
+}
+
+template<typename ResultT>
+typename task<ResultT>::awaiter
+task<ResultT>::operator co_await() const noexcept
+{
+  return awaiter{ m_handle };
+}
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "callable.hpp"
+#include "futex.hpp"
+#include "mpmc_queue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace tmf {
+
+// a work-stealing executor. every worker owns a bounded Chase-Lev deque of `callable<void(), Capacity>` cells:
+// it pushes and pops its own end, idle workers steal the other end of a random victim's, and threads with nothing
+// to do park on a futex. tasks are relocated into the cells with the callable's mover, so nothing is allocated
+// per task. tasks must not throw. `Length` is the number of cells per deque and must be a power of two
+template<size_t Length = 1024, size_t Capacity = default_callable_capacity>
+class thread_pool
+{
+public:
+  static_assert(Length >= 2 && (Length & (Length - 1)) == 0, "`tmf::thread_pool` length must be a power of two");
+
+  using task_type = callable<void(), Capacity>;
+  using this_type = thread_pool<Length, Capacity>;
+
+  // start `threads` workers, at least one
+  explicit thread_pool(size_t threads = std::thread::hardware_concurrency());
+
+  thread_pool(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  // runs every task posted so far, then joins the workers
+  ~thread_pool();
+
+  // build a task from `sources`, taking any sources a `callable` can be constructed with, and queue it. workers
+  // push onto their own deque, other threads onto a shared queue. when the queue is full the caller runs the task
+  template<typename... SourceTs>
+  void post(SourceTs&&... sources);
+
+  // run one queued task on the calling thread, so that a task waiting for others can help instead of blocking.
+  // returns false when no task could be found
+  bool run_one();
+
+  size_t threads() const noexcept;
+
+private:
+  // `full` stays set until a thief has finished moving the task out, so the owner cannot refill the cell early
+  struct cell
+  {
+    std::atomic<bool> full{ false };
+    task_type task;
+  };
+
+  struct worker
+  {
+    alignas(64) std::atomic<std::intptr_t> top{ 0 };
+    alignas(64) std::atomic<std::intptr_t> bottom{ 0 };
+    alignas(64) cell cells[Length];
+  };
+
+  // which worker, if any, of which pool the calling thread is
+  struct context
+  {
+    const this_type* pool = nullptr;
+    size_t index = 0;
+    uint32_t random = 0;
+  };
+
+  static context& current() noexcept;
+
+  static uint32_t next_random(context& state) noexcept;
+
+  bool push(worker& owner, task_type&& task) noexcept;
+
+  bool pop(worker& owner, task_type& task) noexcept;
+
+  bool steal(worker& victim, task_type& task) noexcept;
+
+  // look in the worker's own deque, then the shared queue, then every other worker starting from a random one
+  bool find(context& state, task_type& task) noexcept;
+
+  void work(size_t index);
+
+  void wake_one() noexcept;
+
+  // fixed before any worker starts, unlike the size of `m_threads`
+  size_t m_count;
+  std::unique_ptr<worker[]> m_workers;
+  std::vector<std::thread> m_threads;
+  mpmc_queue<Length, Capacity> m_injected;
+  alignas(64) std::atomic<uint32_t> m_wake;
+  std::atomic<uint32_t> m_sleepers;
+  std::atomic<bool> m_stopping;
+};
+}
+
+#include "thread_pool.inl"
\ No newline at end of file
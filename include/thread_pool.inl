@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+
+namespace tmf {
+
+template<size_t Length, size_t Capacity>
+thread_pool<Length, Capacity>::thread_pool(size_t threads)
+  : m_count(std::max<size_t>(threads, 1))
+  , m_workers(new worker[m_count])
+  , m_wake(0)
+  , m_sleepers(0)
+  , m_stopping(false)
+{
+  m_threads.reserve(m_count);
+  for (size_t index = 0; index < m_count; ++index) {
+    m_threads.emplace_back([this, index] { work(index); });
+  }
+}
+
+template<size_t Length, size_t Capacity>
+thread_pool<Length, Capacity>::~thread_pool()
+{
+  m_stopping.store(true, std::memory_order_seq_cst);
+  m_wake.fetch_add(1, std::memory_order_seq_cst);
+  futex_wake(m_wake, INT_MAX);
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+template<size_t Length, size_t Capacity>
+template<typename... SourceTs>
+void
+thread_pool<Length, Capacity>::post(SourceTs&&... sources)
+{
+  task_type task{ std::forward<SourceTs>(sources)... };
+  auto& state = current();
+  if (!(state.pool == this && push(m_workers[state.index], std::move(task))) && !m_injected.try_push(std::move(task))) {
+    task();
+    return;
+  }
+  wake_one();
+}
+
+template<size_t Length, size_t Capacity>
+bool
+thread_pool<Length, Capacity>::run_one()
+{
+  task_type task;
+  if (!find(current(), task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+size_t
+thread_pool<Length, Capacity>::threads() const noexcept
+{
+  return m_count;
+}
+
+template<size_t Length, size_t Capacity>
+typename thread_pool<Length, Capacity>::context&
+thread_pool<Length, Capacity>::current() noexcept
+{
+  thread_local context state;
+  return state;
+}
+
+template<size_t Length, size_t Capacity>
+uint32_t
+thread_pool<Length, Capacity>::next_random(context& state) noexcept
+{
+  if (state.random == 0) {
+    state.random = static_cast<uint32_t>(reinterpret_cast<std::uintptr_t>(&state) >> 4) | 1;
+  }
+  state.random ^= state.random << 13;
+  state.random ^= state.random >> 17;
+  state.random ^= state.random << 5;
+  return state.random;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+thread_pool<Length, Capacity>::push(worker& owner, task_type&& task) noexcept
+{
+  auto bottom = owner.bottom.load(std::memory_order_relaxed);
+  auto top = owner.top.load(std::memory_order_acquire);
+  auto& claimed = owner.cells[bottom & (Length - 1)];
+  if (bottom - top >= static_cast<std::intptr_t>(Length) || claimed.full.load(std::memory_order_acquire)) {
+    return false;
+  }
+  claimed.task = std::move(task);
+  claimed.full.store(true, std::memory_order_relaxed);
+  owner.bottom.store(bottom + 1, std::memory_order_release);
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+thread_pool<Length, Capacity>::pop(worker& owner, task_type& task) noexcept
+{
+  auto bottom = owner.bottom.load(std::memory_order_relaxed) - 1;
+  owner.bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = owner.top.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    owner.bottom.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+  if (top == bottom) {
+    // the last task, thieves may be racing for it
+    bool won = owner.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    owner.bottom.store(bottom + 1, std::memory_order_relaxed);
+    if (!won) {
+      return false;
+    }
+  }
+  auto& claimed = owner.cells[bottom & (Length - 1)];
+  task = std::move(claimed.task);
+  claimed.full.store(false, std::memory_order_release);
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+thread_pool<Length, Capacity>::steal(worker& victim, task_type& task) noexcept
+{
+  auto top = victim.top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto bottom = victim.bottom.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return false;
+  }
+  // unlike the original deque, the task is only touched once the cell is claimed, because moving it is not a
+  // plain read that could be thrown away
+  if (!victim.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return false;
+  }
+  auto& claimed = victim.cells[top & (Length - 1)];
+  task = std::move(claimed.task);
+  claimed.full.store(false, std::memory_order_release);
+  return true;
+}
+
+template<size_t Length, size_t Capacity>
+bool
+thread_pool<Length, Capacity>::find(context& state, task_type& task) noexcept
+{
+  bool is_worker = state.pool == this;
+  if (is_worker && pop(m_workers[state.index], task)) {
+    return true;
+  }
+  if (m_injected.try_pop(task)) {
+    return true;
+  }
+  auto first = next_random(state) % m_count;
+  for (size_t offset = 0; offset < m_count; ++offset) {
+    auto victim = (first + offset) % m_count;
+    if (!(is_worker && victim == state.index) && steal(m_workers[victim], task)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<size_t Length, size_t Capacity>
+void
+thread_pool<Length, Capacity>::work(size_t index)
+{
+  auto& state = current();
+  state.pool = this;
+  state.index = index;
+  task_type task;
+  for (;;) {
+    if (find(state, task)) {
+      task();
+      // release whatever the task owns now, not when the next one replaces it
+      task = task_type{};
+      continue;
+    }
+    // announce the intent to sleep before looking one last time, a poster either sees the announcement or its
+    // task is found here
+    auto wake = m_wake.load(std::memory_order_acquire);
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    if (find(state, task)) {
+      m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+      task();
+      task = task_type{};
+      continue;
+    }
+    if (m_stopping.load(std::memory_order_seq_cst)) {
+      m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+    futex_wait(m_wake, wake);
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+template<size_t Length, size_t Capacity>
+void
+thread_pool<Length, Capacity>::wake_one() noexcept
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_sleepers.load(std::memory_order_relaxed) != 0) {
+    m_wake.fetch_add(1, std::memory_order_release);
+    futex_wake(m_wake, 1);
+  }
+}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "callable.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace tmf {
+
+// a hierarchical timing wheel: four levels of 256 slots, each slot an intrusive list of timers drawn from a pool
+// fixed at construction. scheduling and cancelling are O(1), advancing costs the timers that fire or move down a
+// level plus at most one step per elapsed tick, stretches in which nothing can happen are skipped. time is counted
+// in whole ticks since `start` and timers fire on the first tick at or after their deadline. not thread-safe
+template<size_t Capacity = default_callable_capacity>
+class timer_wheel
+{
+public:
+  using clock = std::chrono::steady_clock;
+  using callback_type = callable<void(), Capacity>;
+
+  // identifies a scheduled timer, stays harmless to cancel after it fired or its node was reused
+  struct timer
+  {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+  };
+
+  // room for `timers` timers at once
+  timer_wheel(size_t timers, clock::duration tick, clock::time_point start = clock::now());
+
+  timer_wheel(const timer_wheel&) = delete;
+
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  ~timer_wheel();
+
+  // run a callback built from `sources`, taking any sources a `callable` can be constructed with, once `deadline`
+  // has passed. throws if every timer is in use
+  template<typename... SourceTs>
+  timer schedule_at(clock::time_point deadline, SourceTs&&... sources);
+
+  template<typename... SourceTs>
+  timer schedule_after(clock::duration delay, SourceTs&&... sources);
+
+  // returns false if the timer had already fired or been cancelled
+  bool cancel(timer scheduled);
+
+  // run every timer due by `now`, tick by tick, and return how many ran
+  size_t advance(clock::time_point now);
+
+#if defined(__linux__)
+  // a timerfd that becomes readable once per tick, for an event loop to wait on. created on first use
+  int tick_fd();
+
+  // consume the expirations of `tick_fd` and advance to the current time
+  size_t on_tick();
+#endif
+
+  // timers scheduled and not yet run or cancelled
+  size_t pending() const noexcept;
+
+  clock::duration tick() const noexcept;
+
+private:
+  static constexpr std::uint32_t slot_bits = 8;
+  static constexpr std::uint32_t slots_per_level = 1u << slot_bits;
+  static constexpr std::uint32_t levels = 4;
+  static constexpr std::uint32_t no_node = ~std::uint32_t{ 0 };
+
+  struct node
+  {
+    std::uint64_t deadline = 0;
+    std::uint32_t generation = 0;
+    // the slot list the node is in, `no_node` when free
+    std::uint32_t slot = no_node;
+    std::uint32_t previous = no_node;
+    std::uint32_t next = no_node;
+    callback_type callback;
+  };
+
+  template<typename... SourceTs>
+  timer schedule(std::uint64_t deadline, SourceTs&&... sources);
+
+  // the slot a deadline belongs in, seen from the current tick
+  std::uint32_t slot_for(std::uint64_t deadline) const noexcept;
+
+  void link(std::uint32_t index) noexcept;
+
+  void unlink(std::uint32_t index) noexcept;
+
+  void release(std::uint32_t index) noexcept;
+
+  // move every timer of a slot in a higher level down to where it now belongs
+  void cascade(std::uint32_t level) noexcept;
+
+  // run the timers of the level 0 slot for the current tick
+  size_t expire();
+
+  std::unique_ptr<node[]> m_nodes;
+  std::uint32_t m_free;
+  size_t m_pending;
+  std::uint64_t m_current;
+  clock::duration m_tick;
+  clock::time_point m_start;
+  std::uint32_t m_slots[levels * slots_per_level];
+  // timers per level, to skip the ticks in which nothing can happen
+  std::uint32_t m_linked[levels];
+#if defined(__linux__)
+  int m_tick_fd;
+#endif
+};
+}
+
+#include "timer_wheel.inl"
\ No newline at end of file
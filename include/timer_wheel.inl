@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace tmf {
+
+template<size_t Capacity>
+timer_wheel<Capacity>::timer_wheel(size_t timers, clock::duration tick, clock::time_point start)
+  : m_nodes(new node[timers])
+  , m_free(timers == 0 ? no_node : 0)
+  , m_pending(0)
+  , m_current(0)
+  , m_tick(tick)
+  , m_start(start)
+#if defined(__linux__)
+  , m_tick_fd(-1)
+#endif
+{
+  if (tick <= clock::duration::zero() || timers >= no_node) {
+    throw callable_exception{ "a timer wheel needs a positive tick and fewer than 2^32 - 1 timers." };
+  }
+  for (size_t index = 0; index < timers; ++index) {
+    m_nodes[index].next = index + 1 < timers ? static_cast<std::uint32_t>(index + 1) : no_node;
+  }
+  for (auto& head : m_slots) {
+    head = no_node;
+  }
+  for (auto& linked : m_linked) {
+    linked = 0;
+  }
+}
+
+template<size_t Capacity>
+timer_wheel<Capacity>::~timer_wheel()
+{
+#if defined(__linux__)
+  if (m_tick_fd != -1) {
+    ::close(m_tick_fd);
+  }
+#endif
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+typename timer_wheel<Capacity>::timer
+timer_wheel<Capacity>::schedule_at(clock::time_point deadline, SourceTs&&... sources)
+{
+  // round up, a timer never fires early
+  auto ticks = deadline <= m_start ? 0 : ((deadline - m_start) + m_tick - clock::duration{ 1 }) / m_tick;
+  return schedule(static_cast<std::uint64_t>(ticks), std::forward<SourceTs>(sources)...);
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+typename timer_wheel<Capacity>::timer
+timer_wheel<Capacity>::schedule_after(clock::duration delay, SourceTs&&... sources)
+{
+  return schedule_at(m_start + static_cast<std::int64_t>(m_current) * m_tick + delay,
+                     std::forward<SourceTs>(sources)...);
+}
+
+template<size_t Capacity>
+template<typename... SourceTs>
+typename timer_wheel<Capacity>::timer
+timer_wheel<Capacity>::schedule(std::uint64_t deadline, SourceTs&&... sources)
+{
+  if (m_free == no_node) {
+    throw callable_exception{ "every timer of the timer wheel is in use." };
+  }
+  auto index = m_free;
+  auto& scheduled = m_nodes[index];
+  m_free = scheduled.next;
+  // the current tick has already run, overdue timers run on the next one, also when a callback schedules one
+  scheduled.deadline = std::max(deadline, m_current + 1);
+  scheduled.callback = callback_type{ std::forward<SourceTs>(sources)... };
+  link(index);
+  ++m_pending;
+  return timer{ index, scheduled.generation };
+}
+
+template<size_t Capacity>
+bool
+timer_wheel<Capacity>::cancel(timer scheduled)
+{
+  if (scheduled.index >= no_node) {
+    return false;
+  }
+  auto& cancelled = m_nodes[scheduled.index];
+  if (cancelled.generation != scheduled.generation || cancelled.slot == no_node) {
+    return false;
+  }
+  unlink(scheduled.index);
+  release(scheduled.index);
+  return true;
+}
+
+template<size_t Capacity>
+size_t
+timer_wheel<Capacity>::advance(clock::time_point now)
+{
+  if (now <= m_start) {
+    return 0;
+  }
+  auto target = static_cast<std::uint64_t>((now - m_start) / m_tick);
+  size_t ran = 0;
+  while (m_current < target) {
+    // ticks before the next cascade of the lowest occupied level change nothing, skip them
+    std::uint32_t lowest = 0;
+    while (lowest < levels && m_linked[lowest] == 0) {
+      ++lowest;
+    }
+    if (lowest == levels) {
+      m_current = target;
+      break;
+    }
+    if (lowest != 0) {
+      auto span = std::uint64_t{ 1 } << (slot_bits * lowest);
+      auto next_cascade = (m_current | (span - 1)) + 1;
+      m_current = std::min(target, next_cascade) - 1;
+    }
+    ++m_current;
+    for (std::uint32_t level = 1; level < levels && (m_current & ((std::uint64_t{ 1 } << (slot_bits * level)) - 1)) == 0;
+         ++level) {
+      cascade(level);
+    }
+    ran += expire();
+  }
+  return ran;
+}
+
+#if defined(__linux__)
+template<size_t Capacity>
+int
+timer_wheel<Capacity>::tick_fd()
+{
+  if (m_tick_fd != -1) {
+    return m_tick_fd;
+  }
+  auto descriptor = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (descriptor == -1) {
+    throw callable_exception{ std::string{ "timerfd_create failed: " } + std::strerror(errno) };
+  }
+  auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(m_tick).count();
+  itimerspec period{};
+  period.it_interval.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+  period.it_interval.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+  period.it_value = period.it_interval;
+  if (::timerfd_settime(descriptor, 0, &period, nullptr) == -1) {
+    auto error = errno;
+    ::close(descriptor);
+    throw callable_exception{ std::string{ "timerfd_settime failed: " } + std::strerror(error) };
+  }
+  m_tick_fd = descriptor;
+  return m_tick_fd;
+}
+
+template<size_t Capacity>
+size_t
+timer_wheel<Capacity>::on_tick()
+{
+  std::uint64_t expirations = 0;
+  // nothing to read just means the event loop woke up early, the clock decides what is due either way
+  (void)!::read(tick_fd(), &expirations, sizeof(expirations));
+  return advance(clock::now());
+}
+#endif
+
+template<size_t Capacity>
+size_t
+timer_wheel<Capacity>::pending() const noexcept
+{
+  return m_pending;
+}
+
+template<size_t Capacity>
+typename timer_wheel<Capacity>::clock::duration
+timer_wheel<Capacity>::tick() const noexcept
+{
+  return m_tick;
+}
+
+template<size_t Capacity>
+std::uint32_t
+timer_wheel<Capacity>::slot_for(std::uint64_t deadline) const noexcept
+{
+  if (deadline <= m_current) {
+    return static_cast<std::uint32_t>(m_current & (slots_per_level - 1));
+  }
+  auto delta = deadline - m_current;
+  for (std::uint32_t level = 0; level < levels; ++level) {
+    if (delta < (std::uint64_t{ 1 } << (slot_bits * (level + 1)))) {
+      auto position = (deadline >> (slot_bits * level)) & (slots_per_level - 1);
+      return level * slots_per_level + static_cast<std::uint32_t>(position);
+    }
+  }
+  // beyond the reach of the wheel, park it in the furthest slot and place it again when that slot cascades
+  auto furthest = m_current + (std::uint64_t{ 1 } << (slot_bits * levels)) - 1;
+  auto position = (furthest >> (slot_bits * (levels - 1))) & (slots_per_level - 1);
+  return (levels - 1) * slots_per_level + static_cast<std::uint32_t>(position);
+}
+
+template<size_t Capacity>
+void
+timer_wheel<Capacity>::link(std::uint32_t index) noexcept
+{
+  auto& linked = m_nodes[index];
+  linked.slot = slot_for(linked.deadline);
+  ++m_linked[linked.slot / slots_per_level];
+  auto& head = m_slots[linked.slot];
+  linked.previous = no_node;
+  linked.next = head;
+  if (head != no_node) {
+    m_nodes[head].previous = index;
+  }
+  head = index;
+}
+
+template<size_t Capacity>
+void
+timer_wheel<Capacity>::unlink(std::uint32_t index) noexcept
+{
+  auto& unlinked = m_nodes[index];
+  if (unlinked.previous != no_node) {
+    m_nodes[unlinked.previous].next = unlinked.next;
+  } else {
+    m_slots[unlinked.slot] = unlinked.next;
+  }
+  if (unlinked.next != no_node) {
+    m_nodes[unlinked.next].previous = unlinked.previous;
+  }
+  --m_linked[unlinked.slot / slots_per_level];
+  unlinked.slot = no_node;
+}
+
+template<size_t Capacity>
+void
+timer_wheel<Capacity>::release(std::uint32_t index) noexcept
+{
+  auto& released = m_nodes[index];
+  released.callback = callback_type{};
+  ++released.generation;
+  released.next = m_free;
+  m_free = index;
+  --m_pending;
+}
+
+template<size_t Capacity>
+void
+timer_wheel<Capacity>::cascade(std::uint32_t level) noexcept
+{
+  auto position = (m_current >> (slot_bits * level)) & (slots_per_level - 1);
+  auto& head = m_slots[level * slots_per_level + position];
+  auto index = head;
+  head = no_node;
+  while (index != no_node) {
+    auto next = m_nodes[index].next;
+    --m_linked[level];
+    link(index);
+    index = next;
+  }
+}
+
+template<size_t Capacity>
+size_t
+timer_wheel<Capacity>::expire()
+{
+  auto& head = m_slots[m_current & (slots_per_level - 1)];
+  size_t ran = 0;
+  // the callbacks may schedule and cancel timers, including ones in this slot, so take one node at a time
+  while (head != no_node) {
+    auto index = head;
+    unlink(index);
+    auto callback = std::move(m_nodes[index].callback);
+    release(index);
+    callback();
+    ++ran;
+  }
+  return ran;
+}
+}
\ No newline at end of file
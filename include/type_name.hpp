@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string_view>
+
+namespace tmf {
+
+// the name of `T` as the compiler spells it, taken from the signature of this function at compile time, so it
+// needs no RTTI. lambdas are named after the function they appear in
+template<typename T>
+constexpr std::string_view
+type_name() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  std::string_view signature = __FUNCSIG__;
+  auto start = signature.find("type_name<") + 10;
+  auto end = signature.rfind(">(");
+#else
+  // "... type_name() [with T = int; ...]" from gcc, "... type_name() [T = int]" from clang
+  std::string_view signature = __PRETTY_FUNCTION__;
+  auto start = signature.find("T = ") + 4;
+  auto end = signature.find("; ", start);
+  if (end == std::string_view::npos) {
+    end = signature.rfind(']');
+  }
+#endif
+  return signature.substr(start, end - start);
+}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "framework/types.hpp"
+#include "framework/allocations.hpp"
+#include "framework/catch.hpp"
+
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace {
+// run every constructor, assignment and call of `testing_type` on a callable made by `make`, and require that
+// none of them touch the heap. `make` itself is measured as the construction from the source
+template<typename MakeT>
+void
+require_no_allocations(MakeT&& make)
+{
+  alignas(testing_type) unsigned char storage[sizeof(testing_type)];
+  testing_type* subject = nullptr;
+  REQUIRE(allocations::during([&] { subject = new (storage) testing_type{ make() }; }) == 0);
+
+  int ref = 2;
+  const int cref = 3;
+  int pointee = 5;
+  int result = 0;
+  REQUIRE(allocations::during([&] { result = (*subject)(1, ref, cref, 4, &pointee); }) == 0);
+  REQUIRE(result == 15);
+  REQUIRE(allocations::during([&] { result = std::as_const(*subject)(1, ref, cref, 4, &pointee); }) == 0);
+
+  std::tuple<int, int&, int const&, int&&, int*> row{ 1, ref, cref, 4, &pointee };
+  int results[1]{};
+  REQUIRE(allocations::during([&] { subject->invoke_batch(std::span{ &row, 1 }, results); }) == 0);
+
+  REQUIRE(allocations::during([&] {
+            testing_type copied{ std::as_const(*subject) };
+            testing_type moved{ std::move(copied) };
+            testing_type assigned;
+            assigned = std::as_const(moved);
+            assigned = moved;
+            assigned = std::move(moved);
+            result = assigned.empty() ? -1 : assigned(1, ref, cref, 4, &pointee);
+          }) == 0);
+  REQUIRE(result != -1);
+
+  REQUIRE(allocations::during([&] { subject->~testing_type(); }) == 0);
+}
+}
+
+TEST_CASE("the counting allocator sees heap allocations of the calling thread", "[allocation]")
+{
+  // through a volatile, so the pair is not elided
+  static int* volatile held = nullptr;
+  std::size_t counted = allocations::during([] {
+    held = new int{ 0 };
+    delete held;
+  });
+  REQUIRE(counted == 2);
+  int ref = 0;
+  std::size_t thrown = allocations::during([&ref] {
+    try {
+      testing_type{}(0, ref, 0, 0, nullptr);
+    } catch (const tmf::callable_exception&) {
+    }
+  });
+  // the exception of an empty call allocates, keep checking `empty` on paths that must not
+  REQUIRE(thrown > 0);
+}
+
+TEST_CASE("callables never allocate to construct, copy, move, assign, call or destroy", "[allocation]")
+{
+  SECTION("holding a copy of a functor")
+  {
+    require_no_allocations([] { return testing_type{ functor{} }; });
+  }
+  SECTION("referencing a functor")
+  {
+    functor target;
+    require_no_allocations([&] { return testing_type{ target }; });
+  }
+  SECTION("pointing to a functor")
+  {
+    functor target;
+    require_no_allocations([&] { return testing_type{ &target }; });
+  }
+  SECTION("sharing a functor")
+  {
+    auto target = std::make_shared<functor>();
+    require_no_allocations([&] { return testing_type{ target }; });
+  }
+  SECTION("holding a copy of an object and a method")
+  {
+    require_no_allocations([] { return testing_type{ object{}, &object::method }; });
+  }
+  SECTION("referencing an object and a method")
+  {
+    object target;
+    require_no_allocations([&] { return testing_type{ target, &object::method }; });
+  }
+  SECTION("pointing to an object and a method")
+  {
+    object target;
+    require_no_allocations([&] { return testing_type{ &target, &object::method }; });
+  }
+  SECTION("sharing an object and a method")
+  {
+    auto target = std::make_shared<object>();
+    require_no_allocations([&] { return testing_type{ target, &object::method }; });
+  }
+  SECTION("pointing to a free function")
+  {
+    require_no_allocations([] { return testing_type{ &free_function }; });
+  }
+  SECTION("pointing to a static method")
+  {
+    require_no_allocations([] { return testing_type{ &object::static_method }; });
+  }
+  SECTION("holding a lambda")
+  {
+    int offset = 0;
+    require_no_allocations([&] {
+      return testing_type{ [&offset](int val, int& ref, int const& cref, int&& rval, int* ptr) {
+        return offset + parameter_test_function(val, ref, cref, std::move(rval), ptr);
+      } };
+    });
+  }
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <atomic_callable.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("atomic callables call whatever target was stored last", "[atomic_callable]")
+{
+  tmf::atomic_callable<int(int)> subject;
+  REQUIRE(subject.empty());
+  REQUIRE_THROWS_AS(subject(1), tmf::callable_exception);
+  subject.store([](int value) { return value + 1; });
+  REQUIRE_FALSE(subject.empty());
+  REQUIRE(subject(1) == 2);
+  struct multiplier
+  {
+    int times(int value) const { return value * factor; }
+    int factor;
+  };
+  multiplier doubler{ 2 };
+  subject.store(&doubler, &multiplier::times);
+  REQUIRE(subject(3) == 6);
+  auto copy = subject.load();
+  subject.store([](int value) { return -value; });
+  REQUIRE(copy(3) == 6);
+  REQUIRE(subject(3) == -3);
+  subject.store();
+  REQUIRE(subject.empty());
+}
+
+TEST_CASE("atomic callables destroy replaced targets once no call can use them", "[atomic_callable]")
+{
+  int check_value = 0;
+  auto state = std::make_shared<non_trivial_destructing>(&check_value);
+  tmf::atomic_callable<void()> subject{ [state] {} };
+  state.reset();
+  subject();
+  subject.store([] {});
+  REQUIRE(check_value == 1);
+}
+
+TEST_CASE("atomic callables can be replaced while other threads call them", "[atomic_callable]")
+{
+  constexpr int callers = 4;
+  tmf::atomic_callable<long(long)> subject{ [](long value) { return value; } };
+  std::atomic<bool> running{ true };
+  std::atomic<long> mismatches{ 0 };
+  std::vector<std::thread> threads;
+  for (int caller = 0; caller < callers; ++caller) {
+    threads.emplace_back([&] {
+      while (running.load()) {
+        // every target either returns its argument or its argument plus the shared state it owns
+        auto result = subject(10);
+        if (result != 10 && result != 52) {
+          mismatches.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int swap = 0; swap < 2000; ++swap) {
+    auto state = std::make_shared<long>(42);
+    if (swap % 2 == 0) {
+      subject.store([state](long value) { return value + *state; });
+    } else {
+      subject.store([](long value) { return value; });
+    }
+  }
+  running.store(false);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(mismatches == 0);
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <span_kernel.hpp>
+
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("batches of arguments can be passed through a single call", "[batch]")
+{
+  SECTION("as rows of argument tuples")
+  {
+    std::vector<int> ref_data{ 2, 2, 2 };
+    const int const_ref_data{ 3 };
+    std::vector<int> ptr_data{ 5, 5, 5 };
+    std::vector<std::tuple<int, int&, int const&, int&&, int*>> rows;
+    std::vector<int> rvalues{ 4, 4, 4 };
+    for (int index = 0; index < 3; ++index) {
+      rows.emplace_back(index, ref_data[index], const_ref_data, std::move(rvalues[index]), &ptr_data[index]);
+    }
+    std::vector<int> results(3);
+    testing_type subject{ functor{} };
+    subject.invoke_batch(rows, results);
+    REQUIRE(results == std::vector<int>{ 14, 15, 16 });
+    REQUIRE(ref_data == std::vector<int>{ 0, 0, 0 });
+    REQUIRE(ptr_data == std::vector<int>{ 0, 0, 0 });
+  }
+  SECTION("as one column per parameter")
+  {
+    std::vector<int> values{ 0, 1, 2 };
+    std::vector<int> ref_data{ 2, 2, 2 };
+    std::vector<int> const_ref_data{ 3, 3, 3 };
+    std::vector<int> rvalues{ 4, 4, 4 };
+    int ptr_data[]{ 5, 5, 5 };
+    std::vector<int*> pointers{ &ptr_data[0], &ptr_data[1], &ptr_data[2] };
+    std::vector<int> results(3);
+    testing_type subject{ &free_function };
+    subject.invoke_batch(values, ref_data, const_ref_data, rvalues, pointers, results);
+    REQUIRE(results == std::vector<int>{ 14, 15, 16 });
+    REQUIRE(ref_data == std::vector<int>{ 0, 0, 0 });
+    REQUIRE(ptr_data[2] == 0);
+  }
+  SECTION("with every kind of source")
+  {
+    auto square = [](float value) { return value * value; };
+    auto shared_square = std::make_shared<decltype(square)>(square);
+    struct scaler
+    {
+      float scale(float value) { return value * factor; }
+      float factor;
+    } object{ 2.0f };
+    std::vector<float> values{ 1.0f, 2.0f, 3.0f };
+    std::vector<float> results(3);
+
+    tmf::callable<float(float)> by_value{ square };
+    by_value.invoke_batch(values, results);
+    REQUIRE(results == std::vector<float>{ 1.0f, 4.0f, 9.0f });
+
+    tmf::callable<float(float)> by_pointer{ &square };
+    by_pointer.invoke_batch(values, results);
+    REQUIRE(results == std::vector<float>{ 1.0f, 4.0f, 9.0f });
+
+    tmf::callable<float(float)> by_shared_pointer{ shared_square };
+    by_shared_pointer.invoke_batch(values, results);
+    REQUIRE(results == std::vector<float>{ 1.0f, 4.0f, 9.0f });
+
+    tmf::callable<float(float)> by_member{ &object, &scaler::scale };
+    by_member.invoke_batch(values, results);
+    REQUIRE(results == std::vector<float>{ 2.0f, 4.0f, 6.0f });
+  }
+  SECTION("by-value arguments are copied from rows, which are left as they were")
+  {
+    std::vector<std::tuple<std::string>> rows{ { "first" }, { "second" } };
+    std::vector<size_t> results(2);
+    tmf::callable<size_t(std::string)> subject{ [](std::string text) {
+      auto taken = std::move(text);
+      return taken.size();
+    } };
+    subject.invoke_batch(rows, results);
+    REQUIRE(results == std::vector<size_t>{ 5, 6 });
+    REQUIRE(std::get<0>(rows[0]) == "first");
+    REQUIRE(std::get<0>(rows[1]) == "second");
+  }
+  SECTION("results can be discarded, or not exist")
+  {
+    int total = 0;
+    auto accumulate = [&total](int value) { total += value; };
+    std::vector<int> values{ 1, 2, 3 };
+    tmf::callable<void(int)> subject{ accumulate };
+    subject.invoke_batch(values);
+    REQUIRE(total == 6);
+  }
+  SECTION("mismatched spans and empty callables throw")
+  {
+    std::vector<int> values{ 1, 2, 3 };
+    std::vector<int> short_results(2);
+    tmf::callable<int(int, int)> subject{ [](int a, int b) { return a + b; } };
+    std::vector<int> other_values{ 1, 2 };
+    REQUIRE_THROWS_AS(subject.invoke_batch(values, other_values), tmf::callable_exception);
+    REQUIRE_THROWS_AS(subject.invoke_batch(values, values, short_results), tmf::callable_exception);
+    tmf::callable<int(int, int)> empty_subject{};
+    REQUIRE_THROWS_AS(empty_subject.invoke_batch(values, values), tmf::callable_exception);
+  }
+}
+TEST_CASE("scalar callables can be lifted to span kernels", "[batch]")
+{
+  std::vector<float> input{ 1.0f, 2.0f, 3.0f };
+  std::vector<float> output(3);
+  tmf::span_kernel<float(float)> kernel{ [](float value) { return value + 0.5f; } };
+  kernel(input, output);
+  REQUIRE(output == std::vector<float>{ 1.5f, 2.5f, 3.5f });
+  REQUIRE(kernel(1.0f) == 1.5f);
+  SECTION("and type-erased as kernels")
+  {
+    tmf::callable<tmf::span_kernel<float(float)>::kernel_type, 2 * sizeof(kernel)> erased{ kernel };
+    erased(output, output);
+    REQUIRE(output == std::vector<float>{ 2.0f, 3.0f, 4.0f });
+  }
+  SECTION("but not with a short output")
+  {
+    std::vector<float> short_output(2);
+    REQUIRE_THROWS_AS(kernel(input, short_output), tmf::callable_exception);
+  }
+}
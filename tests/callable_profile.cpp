@@ -0,0 +1,128 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <callable.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if defined(TMF_CALLABLE_PROFILE)
+namespace {
+struct hot_handler
+{
+  int operator()(int value) const { return value + 1; }
+};
+
+struct cold_handler
+{
+  int operator()(int value) const { return value - 1; }
+};
+
+int
+tripled(int value)
+{
+  return value * 3;
+}
+}
+
+TEST_CASE("dispatch pointers are shared by every callable of the same target type", "[callable_profile]")
+{
+  tmf::callable<int(int)> first{ hot_handler{} };
+  tmf::callable<int(int)> second{ hot_handler{} };
+  tmf::callable<int(int)> other{ cold_handler{} };
+  tmf::callable<int(int)> empty;
+  REQUIRE(first.dispatch() != nullptr);
+  REQUIRE(first.dispatch() == second.dispatch());
+  REQUIRE(first.dispatch() != other.dispatch());
+  REQUIRE(empty.dispatch() == nullptr);
+  REQUIRE(tmf::describe(empty) == "empty");
+}
+
+TEST_CASE("dispatch pointers are named after the target type", "[callable_profile]")
+{
+  tmf::callable<int(int)> hot{ hot_handler{} };
+  tmf::callable<int(int)> function{ &tripled };
+  REQUIRE(tmf::describe(hot) == tmf::type_name<hot_handler>());
+  REQUIRE(tmf::describe(function) == tmf::type_name<int (*)(int)>());
+  REQUIRE(tmf::callable_profile::symbolize(hot.dispatch()) == tmf::describe(hot));
+}
+
+TEST_CASE("dispatch pointers are named for every capacity holding the target type", "[callable_profile]")
+{
+  tmf::callable<int(int), 32> small{ hot_handler{} };
+  tmf::callable<int(int), 64> large{ hot_handler{} };
+  tmf::callable<int(int), 128> larger{ hot_handler{} };
+  REQUIRE(small.dispatch() != large.dispatch());
+  REQUIRE(tmf::describe(small) == tmf::type_name<hot_handler>());
+  REQUIRE(tmf::describe(large) == tmf::type_name<hot_handler>());
+  REQUIRE(tmf::describe(larger) == tmf::type_name<hot_handler>());
+}
+
+TEST_CASE("unregistered addresses are symbolized through the dynamic symbol table", "[callable_profile]")
+{
+  auto name = tmf::callable_profile::symbolize(reinterpret_cast<const void*>(&std::abort));
+  REQUIRE(name.find("abort") != std::string::npos);
+}
+
+TEST_CASE("demangled trampolines are named after the type they were bound for", "[callable_profile]")
+{
+  REQUIRE(tmf::bound_target("tmf::callable<int (int), 32ul>::bind<tmf::detail::member_function<handler, int "
+                            "(handler::*)(int) const, int, int> >()::{lambda(bool, int)#1}::_FUN(bool, int)") ==
+          "tmf::detail::member_function<handler, int (handler::*)(int) const, int, int>");
+  REQUIRE(tmf::bound_target("main") == "main");
+}
+
+TEST_CASE("sampling counts one call in every period", "[callable_profile]")
+{
+  tmf::callable<int(int)> hot{ hot_handler{} };
+  tmf::callable<int(int)> cold{ cold_handler{} };
+  tmf::callable_profile::reset();
+  for (int call = 0; call < 10; ++call) {
+    hot(call);
+  }
+  REQUIRE(tmf::callable_profile::top(10).empty());
+
+  tmf::callable_profile::sampling(1);
+  for (int call = 0; call < 10; ++call) {
+    hot(call);
+  }
+  cold(1);
+  tmf::callable_profile::sampling(4);
+  for (int call = 0; call < 20; ++call) {
+    hot(call);
+  }
+  tmf::callable_profile::sampling(0);
+
+  auto targets = tmf::callable_profile::top(10);
+  REQUIRE(targets.size() == 2);
+  REQUIRE(targets[0].name == tmf::type_name<hot_handler>());
+  REQUIRE(targets[0].samples == 15);
+  REQUIRE(targets[1].name == tmf::type_name<cold_handler>());
+  REQUIRE(targets[1].samples == 1);
+  REQUIRE(tmf::callable_profile::top(1).size() == 1);
+
+  auto report = tmf::callable_profile::report(10);
+  auto hot_line = report.find(std::string{ tmf::type_name<hot_handler>() });
+  REQUIRE(hot_line < report.find(std::string{ tmf::type_name<cold_handler>() }));
+  REQUIRE(report.find("93.75%") != std::string::npos);
+}
+
+TEST_CASE("each thread counts down a period of its own", "[callable_profile]")
+{
+  tmf::callable<int(int)> hot{ hot_handler{} };
+  tmf::callable_profile::reset();
+  tmf::callable_profile::sampling(2);
+  std::thread worker{ [&hot] {
+    for (int call = 0; call < 3; ++call) {
+      hot(call);
+    }
+  } };
+  worker.join();
+  for (int call = 0; call < 3; ++call) {
+    hot(call);
+  }
+  tmf::callable_profile::sampling(0);
+  REQUIRE(tmf::callable_profile::top(1).at(0).samples == 2);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <callable.hpp>
+
+#include <string>
+
+#if defined(TMF_CALLABLE_SIZES)
+namespace {
+template<size_t Bytes>
+struct payload
+{
+  int operator()(int value) const { return value + static_cast<int>(data[0]); }
+
+  char data[Bytes] = {};
+};
+
+template<typename FunctorT>
+using stored_type = tmf::stored_functor_t<FunctorT, int, int>;
+
+template<typename FunctorT>
+constexpr size_t stored_size = sizeof(stored_type<FunctorT>);
+
+constexpr size_t
+rounded(size_t size)
+{
+  return (size + tmf::callable_sizes::granularity - 1) / tmf::callable_sizes::granularity *
+         tmf::callable_sizes::granularity;
+}
+
+using sized_callable = tmf::callable<int(int), 64>;
+
+const tmf::callable_sizes&
+sizes()
+{
+  return tmf::callable_sizes::of<sized_callable>(tmf::type_name<sized_callable>(), 64);
+}
+}
+
+TEST_CASE("callable sizes record every target a callable is constructed from", "[callable_sizes]")
+{
+  tmf::callable_sizes::reset();
+  sized_callable small{ payload<4>{} };
+  sized_callable large{ payload<40>{} };
+  sized_callable copied{ std::as_const(small) };
+  sized_callable moved{ std::move(large) };
+  REQUIRE(sizes().name == tmf::type_name<sized_callable>());
+  REQUIRE(sizes().capacity == 64);
+  REQUIRE(sizes().constructions == 2);
+  REQUIRE(sizes().largest == stored_size<payload<40>>);
+  REQUIRE(sizes().wasted_bytes == 128 - stored_size<payload<4>> - stored_size<payload<40>>);
+  REQUIRE(sizes().alignment == alignof(stored_type<payload<40>>));
+}
+
+TEST_CASE("callable sizes recommend the capacity that fits a percentile of targets", "[callable_sizes]")
+{
+  tmf::callable_sizes::reset();
+  REQUIRE(sizes().recommend(99.0) == 0);
+  for (int construction = 0; construction < 99; ++construction) {
+    sized_callable small{ payload<4>{} };
+  }
+  sized_callable large{ payload<40>{} };
+  REQUIRE(sizes().recommend(50.0) == rounded(stored_size<payload<4>>));
+  REQUIRE(sizes().recommend(99.0) == rounded(stored_size<payload<4>>));
+  REQUIRE(sizes().recommend(100.0) == rounded(stored_size<payload<40>>));
+
+  auto report = tmf::callable_sizes::report(99.0);
+  REQUIRE(report.find(std::string{ tmf::type_name<sized_callable>() }) != std::string::npos);
+  REQUIRE(report.find("100 constructions") != std::string::npos);
+  REQUIRE(report.find("p99 fits in " + std::to_string(rounded(stored_size<payload<4>>))) != std::string::npos);
+  REQUIRE(report.find("all fit in " + std::to_string(rounded(stored_size<payload<40>>))) != std::string::npos);
+}
+
+TEST_CASE("callable sizes count oversized targets in the last bucket", "[callable_sizes]")
+{
+  tmf::callable_sizes sizes{ "huge", 4096 };
+  sizes.record(2048, 8);
+  sizes.record(16, 8);
+  REQUIRE(sizes.histogram[tmf::callable_sizes::buckets - 1] == 1);
+  REQUIRE(sizes.recommend(50.0) == 16);
+  REQUIRE(sizes.recommend(100.0) == 2048);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <callable.hpp>
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(TMF_CALLABLE_STATS)
+namespace {
+struct counted_handler
+{
+  int operator()(int value) const { return value + 1; }
+};
+
+struct other_handler
+{
+  int operator()(int value) const { return value - 1; }
+};
+
+int
+doubled(int value)
+{
+  return value * 2;
+}
+
+const tmf::callable_stats*
+find(std::string_view name)
+{
+  for (auto stats = tmf::callable_stats::first(); stats != nullptr; stats = stats->next) {
+    if (stats->name == name) {
+      return stats;
+    }
+  }
+  return nullptr;
+}
+}
+
+TEST_CASE("type names are taken from the compiler at compile time", "[callable_stats]")
+{
+  static_assert(tmf::type_name<int>() == "int");
+  REQUIRE(tmf::type_name<counted_handler>().find("counted_handler") != std::string_view::npos);
+  REQUIRE(tmf::target_name<tmf::member_function_raw_pointer<other_handler,
+                                                            int (other_handler::*)(int) const,
+                                                            int,
+                                                            int>>::value == tmf::type_name<other_handler>());
+}
+
+TEST_CASE("callable stats count the calls of every target type", "[callable_stats]")
+{
+  tmf::callable_stats::reset();
+  tmf::callable<int(int)> first{ counted_handler{} };
+  tmf::callable<int(int)> second{ other_handler{} };
+  tmf::callable<int(int)> third{ &doubled };
+  for (int call = 0; call < 3; ++call) {
+    first(call);
+  }
+  second(1);
+  third(1);
+  auto counted = find(tmf::type_name<counted_handler>());
+  REQUIRE(counted != nullptr);
+  REQUIRE(counted->calls == 3);
+  REQUIRE(counted->timed_calls == 0);
+  REQUIRE(find(tmf::type_name<other_handler>())->calls == 1);
+  REQUIRE(find(tmf::type_name<int (*)(int)>())->calls == 1);
+  std::vector<std::tuple<int>> rows{ { 1 }, { 2 } };
+  std::vector<int> results(2);
+  first.invoke_batch(rows, results);
+  REQUIRE(counted->calls == 5);
+  tmf::callable_stats::reset();
+  REQUIRE(counted->calls == 0);
+}
+
+TEST_CASE("callable stats time calls into a histogram while timing is on", "[callable_stats]")
+{
+  tmf::callable_stats::reset();
+  tmf::callable_stats::timing(true);
+  tmf::callable<void()> sleeper{ [] { std::this_thread::sleep_for(std::chrono::microseconds{ 200 }); } };
+  sleeper();
+  sleeper();
+  tmf::callable_stats::timing(false);
+  sleeper();
+  const tmf::callable_stats* stats = nullptr;
+  for (auto entry = tmf::callable_stats::first(); entry != nullptr; entry = entry->next) {
+    if (entry->calls == 3) {
+      stats = entry;
+    }
+  }
+  REQUIRE(stats != nullptr);
+  REQUIRE(stats->timed_calls == 2);
+  REQUIRE(stats->timed_nanoseconds >= 400000);
+  std::uint64_t bucketed = 0;
+  for (std::size_t index = 0; index < tmf::callable_stats::buckets; ++index) {
+    bucketed += stats->histogram[index];
+    if (stats->histogram[index] != 0) {
+      // 200 microseconds fall in the 2^18 bucket at the earliest
+      REQUIRE(index >= 18);
+    }
+  }
+  REQUIRE(bucketed == 2);
+  REQUIRE(tmf::callable_stats::bucket(0) == 0);
+  REQUIRE(tmf::callable_stats::bucket(1) == 1);
+  REQUIRE(tmf::callable_stats::bucket(1023) == 10);
+  REQUIRE(tmf::callable_stats::bucket(1024) == 11);
+}
+
+TEST_CASE("callable stats are dumped as JSON", "[callable_stats]")
+{
+  tmf::callable_stats::reset();
+  tmf::callable<int(int)> subject{ counted_handler{} };
+  subject(1);
+  auto document = tmf::callable_stats::json();
+  auto entry = document.find(std::string{ tmf::type_name<counted_handler>() });
+  REQUIRE(entry != std::string::npos);
+  REQUIRE(document.find("\"calls\": 1", entry) != std::string::npos);
+  REQUIRE(document.find(std::string{ tmf::type_name<other_handler>() }) == std::string::npos);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <callable.hpp>
+
+#include <string>
+#include <thread>
+
+#if defined(TMF_CALLABLE_TRACE)
+namespace {
+struct traced_handler
+{
+  void operator()() const {}
+};
+
+struct tagged_handler
+{
+  void operator()() const {}
+};
+
+size_t
+occurrences(const std::string& document, const std::string& text)
+{
+  size_t count = 0;
+  for (auto found = document.find(text); found != std::string::npos; found = document.find(text, found + 1)) {
+    ++count;
+  }
+  return count;
+}
+}
+
+template<>
+struct tmf::trace_tag<tagged_handler>
+{
+  static constexpr std::string_view value = "tagged";
+};
+
+TEST_CASE("callable traces record nothing while disabled", "[callable_trace]")
+{
+  tmf::callable_trace::json();
+  tmf::callable<void()> subject{ traced_handler{} };
+  subject();
+  REQUIRE(occurrences(tmf::callable_trace::json(), "\"ph\"") == 0);
+}
+
+TEST_CASE("callable traces record a begin and an end event per call", "[callable_trace]")
+{
+  tmf::callable_trace::json();
+  tmf::callable_trace::enable(true);
+  tmf::callable<void()> inner{ tagged_handler{} };
+  tmf::callable<void()> outer{ [&inner] { inner(); } };
+  outer();
+  std::thread other{ [] {
+    tmf::callable<void()> elsewhere{ tagged_handler{} };
+    elsewhere();
+  } };
+  other.join();
+  tmf::callable_trace::enable(false);
+  auto document = tmf::callable_trace::json();
+  REQUIRE(occurrences(document, "\"name\":\"tagged\",\"ph\":\"B\"") == 2);
+  REQUIRE(occurrences(document, "\"name\":\"tagged\",\"ph\":\"E\"") == 2);
+  REQUIRE(occurrences(document, "\"ph\":\"B\"") == 3);
+  REQUIRE(occurrences(document, "\"ph\":\"E\"") == 3);
+  REQUIRE(occurrences(tmf::callable_trace::json(), "\"ph\"") == 0);
+}
+
+TEST_CASE("callable traces drop events once a buffer is full", "[callable_trace]")
+{
+  tmf::callable_trace::json();
+  auto dropped = tmf::callable_trace::dropped();
+  tmf::callable_trace::enable(true);
+  tmf::callable<void()> subject{ traced_handler{} };
+  for (size_t call = 0; call < tmf::callable_trace::events_per_thread; ++call) {
+    subject();
+  }
+  tmf::callable_trace::enable(false);
+  // half the calls find the buffer full on begin, and leave out their end as well
+  REQUIRE(tmf::callable_trace::dropped() - dropped == tmf::callable_trace::events_per_thread / 2);
+  auto document = tmf::callable_trace::json();
+  REQUIRE(occurrences(document, "\"ph\"") == tmf::callable_trace::events_per_thread);
+}
+
+TEST_CASE("callable traces record no end for a begin they dropped", "[callable_trace]")
+{
+  tmf::callable_trace::json();
+  tmf::callable_trace::enable(true);
+  tmf::callable<void()> subject{ traced_handler{} };
+  for (size_t call = 0; call < tmf::callable_trace::events_per_thread / 2; ++call) {
+    subject();
+  }
+  // the buffer is full when this call begins, and drained before it ends
+  std::string drained;
+  tmf::callable<void()> draining{ [&drained] { drained = tmf::callable_trace::json(); } };
+  draining();
+  tmf::callable_trace::enable(false);
+  REQUIRE(occurrences(drained, "\"ph\"") == tmf::callable_trace::events_per_thread);
+  auto document = tmf::callable_trace::json();
+  REQUIRE(occurrences(document, "\"ph\":\"B\"") == occurrences(document, "\"ph\":\"E\""));
+}
+
+TEST_CASE("callable traces reuse the drained buffers of threads that exited", "[callable_trace]")
+{
+  tmf::callable_trace::json();
+  tmf::callable_trace::enable(true);
+  auto traced = [] {
+    tmf::callable<void()> subject{ traced_handler{} };
+    subject();
+  };
+  std::thread{ traced }.join();
+  auto buffers = tmf::callable_trace::buffer_count();
+  for (int thread = 0; thread < 8; ++thread) {
+    REQUIRE(occurrences(tmf::callable_trace::json(), "\"ph\"") == 2);
+    std::thread{ traced }.join();
+  }
+  // a buffer holding events nobody drained yet is not taken over
+  std::thread{ traced }.join();
+  tmf::callable_trace::enable(false);
+  REQUIRE(tmf::callable_trace::buffer_count() == buffers + 1);
+  REQUIRE(occurrences(tmf::callable_trace::json(), "\"ph\"") == 4);
+}
+#endif
\ No newline at end of file
@@ -1,9 +1,23 @@
 #include "framework/types.hpp"
 #include "framework/catch.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <type_traits>
 
+namespace {
+// the deleter, the caller and the table of a target type's operations, then the empty flag, then the storage. the
+// layout must not depend on the language mode, c++17 and c++20 translation units of one program share callables
+template<size_t Capacity>
+constexpr size_t expected_size =
+  (3 * sizeof(void*) + sizeof(bool) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+    alignof(std::max_align_t) +
+  (Capacity + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+static_assert(sizeof(testing_type) == expected_size<tmf::default_callable_capacity>);
+static_assert(sizeof(tmf::callable<void(), 64>) == expected_size<64>);
+}
+
 TEST_CASE("callables can be constructed from various sources", "[construct]")
 {
   SECTION("callables can be copied or moved from other callables of the same type")
@@ -0,0 +1,77 @@
+#include "allocations.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local std::size_t made_count = 0;
+thread_local std::size_t released_count = 0;
+}
+
+namespace allocations {
+
+std::size_t
+made() noexcept
+{
+  return made_count;
+}
+
+std::size_t
+released() noexcept
+{
+  return released_count;
+}
+}
+
+// the array and nothrow forms of the standard library forward to these. sized deallocations do not, and are
+// replaced below as well
+void*
+operator new(std::size_t size)
+{
+  ++made_count;
+  if (auto memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc{};
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+  ++made_count;
+  auto align = static_cast<std::size_t>(alignment);
+  if (auto memory = std::aligned_alloc(align, size == 0 ? align : (size + align - 1) / align * align)) {
+    return memory;
+  }
+  throw std::bad_alloc{};
+}
+
+void
+operator delete(void* memory) noexcept
+{
+  if (memory != nullptr) {
+    ++released_count;
+  }
+  std::free(memory);
+}
+
+void
+operator delete(void* memory, std::align_val_t) noexcept
+{
+  if (memory != nullptr) {
+    ++released_count;
+  }
+  std::free(memory);
+}
+
+void
+operator delete(void* memory, std::size_t) noexcept
+{
+  ::operator delete(memory);
+}
+
+void
+operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept
+{
+  ::operator delete(memory, alignment);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+// global `operator new` and `operator delete` are replaced by counting versions in *allocations.cpp*, which every
+// test links. counts are kept per thread, so other threads allocating meanwhile do not disturb a measurement
+namespace allocations {
+
+// allocations and deallocations made by the calling thread so far
+std::size_t made() noexcept;
+
+std::size_t released() noexcept;
+
+// counts what the calling thread allocates and deallocates between construction and each query. Catch allocates
+// to record assertions, so read the counts before asserting anything about them
+class counter
+{
+public:
+  counter() noexcept
+    : m_made(made())
+    , m_released(released())
+  {}
+
+  std::size_t allocations() const noexcept { return made() - m_made; }
+
+  std::size_t deallocations() const noexcept { return released() - m_released; }
+
+private:
+  std::size_t m_made;
+  std::size_t m_released;
+};
+
+// the allocations and deallocations made by the calling thread while running `body`
+template<typename BodyT>
+std::size_t
+during(BodyT&& body)
+{
+  counter counted;
+  body();
+  return counted.allocations() + counted.deallocations();
+}
+}
\ No newline at end of file
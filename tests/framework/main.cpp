@@ -1,2 +1,4 @@
 #define CATCH_CONFIG_MAIN
+// catch's alternate signal stack is sized with `SIGSTKSZ`, which newer glibc no longer defines as a constant
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include "catch.hpp"
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <fused.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+int
+parse(const std::string& text)
+{
+  return std::stoi(text);
+}
+
+std::string
+describe(int value)
+{
+  return "#" + std::to_string(value);
+}
+}
+
+TEST_CASE("fused stages run in order and pass their results along", "[fused]")
+{
+  std::vector<int> order;
+  auto subject = tmf::chain<const std::string&>(parse)
+                   .then([&order](int value) {
+                     order.push_back(0);
+                     return value * 2;
+                   })
+                   .then([&order](int value) {
+                     order.push_back(1);
+                     return static_cast<double>(value) / 4;
+                   });
+  static_assert(std::is_same<decltype(subject)::result_type, double>::value);
+  REQUIRE(subject("10") == 5.0);
+  REQUIRE(order == std::vector<int>{ 0, 1 });
+}
+
+TEST_CASE("fused stages after a void stage receive nothing", "[fused]")
+{
+  int stored = 0;
+  auto subject = tmf::chain<int, int>([](int left, int right) { return left + right; })
+                   .then([&stored](int sum) { stored = sum; })
+                   .then([&stored] { return stored * 10; });
+  REQUIRE(subject(1, 2) == 30);
+  REQUIRE(stored == 3);
+}
+
+TEST_CASE("fused function stages are called like function pointers", "[fused]")
+{
+  auto subject = tmf::chain<const std::string&>(tmf::stage<parse>).then(tmf::stage<describe>);
+  REQUIRE(subject("12") == "#12");
+}
+
+TEST_CASE("fused pipelines are held by callables as one target", "[fused]")
+{
+  int stored = 0;
+  auto pipeline = tmf::chain<const std::string&>(parse).then([&stored](int value) { stored = value; });
+  REQUIRE(decltype(pipeline)::fits_in<tmf::default_callable_capacity>);
+  tmf::callable<void(const std::string&)> subject{ std::move(pipeline) };
+  subject("42");
+  REQUIRE(stored == 42);
+  auto converted = tmf::chain<int>([](int value) { return value + 1; }).to_callable<16>();
+  static_assert(std::is_same<decltype(converted), tmf::callable<int(int), 16>>::value);
+  REQUIRE(converted(1) == 2);
+}
+
+TEST_CASE("fused pipelines report whether they fit a capacity", "[fused]")
+{
+  std::array<std::uint64_t, 4> padding{};
+  auto small = tmf::chain<int>([](int value) { return value; }).then([](int value) { return value; });
+  auto large = small.then([padding](int value) { return value + static_cast<int>(padding[0]); });
+  REQUIRE(decltype(small)::fits_in<16>);
+  REQUIRE_FALSE(decltype(large)::fits_in<32>);
+  REQUIRE(decltype(large)::fits_in<64>);
+  REQUIRE(large.to_callable<64>()(3) == 3);
+}
+
+TEST_CASE("fused stages are released with the pipeline", "[fused]")
+{
+  auto state = std::make_shared<int>(7);
+  {
+    auto pipeline = tmf::chain<>([state] { return *state; }).then([](int value) { return value + 1; });
+    auto held = pipeline.to_callable();
+    REQUIRE(state.use_count() == 3);
+    REQUIRE(held() == 8);
+    REQUIRE(pipeline() == 8);
+  }
+  REQUIRE(state.use_count() == 1);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <mpmc_queue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("mpmc queues hand out tasks in order", "[mpmc_queue]")
+{
+  tmf::mpmc_queue<4> subject;
+  std::vector<int> order;
+  REQUIRE(subject.empty());
+  for (int index = 0; index < 4; ++index) {
+    REQUIRE(subject.try_emplace([&order, index] { order.push_back(index); }));
+  }
+  SECTION("and refuse tasks when full")
+  {
+    REQUIRE_FALSE(subject.try_emplace([] {}));
+    REQUIRE(subject.size() == 4);
+  }
+  tmf::mpmc_queue<4>::task_type task;
+  while (subject.try_pop(task)) {
+    task();
+  }
+  REQUIRE(order == std::vector<int>{ 0, 1, 2, 3 });
+  REQUIRE(subject.empty());
+  SECTION("and refuse to pop when empty") { REQUIRE_FALSE(subject.try_pop(task)); }
+}
+
+TEST_CASE("mpmc queues relocate task state without leaking it", "[mpmc_queue]")
+{
+  int check_value = 0;
+  {
+    tmf::mpmc_queue<2> subject;
+    auto state = std::make_shared<non_trivial_destructing>(&check_value);
+    REQUIRE(subject.try_emplace([state] {}));
+    state.reset();
+    tmf::mpmc_queue<2>::task_type task;
+    REQUIRE(subject.try_pop(task));
+    REQUIRE(check_value == 0);
+    task = {};
+    REQUIRE(check_value == 1);
+    REQUIRE(subject.try_emplace(+[] {}));
+  }
+  REQUIRE(check_value == 1);
+}
+
+TEST_CASE("mpmc queues run every task pushed by many threads exactly once", "[mpmc_queue]")
+{
+  constexpr int producers = 3;
+  constexpr int consumers = 3;
+  constexpr int tasks_per_producer = 5000;
+  tmf::mpmc_queue<64> subject;
+  std::atomic<long> total{ 0 };
+  std::atomic<int> consumed{ 0 };
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < producers; ++producer) {
+    threads.emplace_back([&] {
+      for (int index = 1; index <= tasks_per_producer; ++index) {
+        while (!subject.try_emplace([&total, index] { total.fetch_add(index); })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int consumer = 0; consumer < consumers; ++consumer) {
+    threads.emplace_back([&] {
+      tmf::mpmc_queue<64>::task_type task;
+      while (consumed.load() < producers * tasks_per_producer) {
+        if (subject.try_pop(task)) {
+          task();
+          consumed.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(total == long{ producers } * tasks_per_producer * (tasks_per_producer + 1) / 2);
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <packaged_task.hpp>
+#include <thread_pool.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+TEST_CASE("packaged tasks hand their result to a future", "[packaged_task]")
+{
+  tmf::future_state<int> slot;
+  tmf::packaged_task<int(int, int)> task{ [](int lhs, int rhs) { return lhs + rhs; } };
+  REQUIRE(task.valid());
+  auto result = task.get_future(slot);
+  REQUIRE(slot.busy());
+  REQUIRE(result.valid());
+  REQUIRE_FALSE(result.ready());
+  task(2, 3);
+  REQUIRE(result.ready());
+  REQUIRE(result.get() == 5);
+  REQUIRE_FALSE(result.valid());
+  REQUIRE_FALSE(slot.busy());
+  SECTION("and refuse to run twice") { REQUIRE_THROWS_AS(task(1, 1), tmf::callable_exception); }
+  SECTION("and leave the slot free for the next task")
+  {
+    tmf::packaged_task<int(int, int)> next{ [](int lhs, int rhs) { return lhs * rhs; } };
+    auto next_result = next.get_future(slot);
+    next(2, 3);
+    REQUIRE(next_result.get() == 6);
+  }
+}
+
+TEST_CASE("packaged tasks refuse slots that are in use", "[packaged_task]")
+{
+  tmf::future_state<void> slot;
+  tmf::packaged_task<void()> task{ [] {} };
+  tmf::packaged_task<void()> other{ [] {} };
+  auto result = task.get_future(slot);
+  REQUIRE_THROWS_AS(task.get_future(slot), tmf::callable_exception);
+  REQUIRE_THROWS_AS(other.get_future(slot), tmf::callable_exception);
+  task();
+  result.get();
+}
+
+TEST_CASE("packaged tasks hand exceptions to a future", "[packaged_task]")
+{
+  tmf::future_state<std::string> slot;
+  SECTION("thrown by the target")
+  {
+    tmf::packaged_task<std::string()> task{ []() -> std::string { throw std::logic_error{ "failed" }; } };
+    auto result = task.get_future(slot);
+    task();
+    REQUIRE_THROWS_AS(result.get(), std::logic_error);
+  }
+  SECTION("when destroyed before running")
+  {
+    tmf::future<std::string> result;
+    {
+      tmf::packaged_task<std::string()> task{ [] { return std::string{ "unused" }; } };
+      result = task.get_future(slot);
+    }
+    REQUIRE(result.ready());
+    REQUIRE_THROWS_AS(result.get(), tmf::callable_exception);
+  }
+  REQUIRE_FALSE(slot.busy());
+}
+
+TEST_CASE("futures release results they never returned", "[packaged_task]")
+{
+  int check_value = 0;
+  tmf::future_state<std::shared_ptr<non_trivial_destructing>> slot;
+  {
+    tmf::packaged_task<std::shared_ptr<non_trivial_destructing>()> task{ [&check_value] {
+      return std::make_shared<non_trivial_destructing>(&check_value);
+    } };
+    auto result = task.get_future(slot);
+    task();
+    REQUIRE(check_value == 0);
+  }
+  REQUIRE(check_value == 1);
+  REQUIRE_FALSE(slot.busy());
+}
+
+TEST_CASE("future arenas lend slots until they are all busy", "[packaged_task]")
+{
+  tmf::future_arena<int, 2> arena;
+  tmf::packaged_task<int()> first{ [] { return 1; } };
+  tmf::packaged_task<int()> second{ [] { return 2; } };
+  tmf::packaged_task<int()> third{ [] { return 3; } };
+  auto first_result = first.get_future(arena);
+  auto second_result = second.get_future(arena);
+  REQUIRE_THROWS_AS(third.get_future(arena), tmf::callable_exception);
+  first();
+  REQUIRE(first_result.get() == 1);
+  auto third_result = third.get_future(arena);
+  third();
+  second();
+  REQUIRE(third_result.get() == 3);
+  REQUIRE(second_result.get() == 2);
+}
+
+TEST_CASE("futures wait for tasks run on other threads", "[packaged_task]")
+{
+  tmf::thread_pool<64> pool{ 2 };
+  tmf::future_arena<long, 64> arena;
+  for (int round = 0; round < 200; ++round) {
+    tmf::packaged_task<long(long)> task{ [](long value) {
+      std::this_thread::yield();
+      return value * 2;
+    } };
+    auto result = task.get_future(arena);
+    pool.post([&task, round] { task(round); });
+    REQUIRE(result.get() == round * 2);
+  }
+}
\ No newline at end of file
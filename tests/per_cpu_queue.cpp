@@ -0,0 +1,73 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <per_cpu_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("per cpu queues run posted tasks from the local queue first", "[per_cpu_queue]")
+{
+  tmf::per_cpu_queue<4> subject{ 3 };
+  REQUIRE(subject.queues() == 3);
+  REQUIRE(subject.local() < 3);
+  std::vector<int> order;
+  REQUIRE(subject.try_post([&order] { order.push_back(0); }));
+  REQUIRE(subject.try_post([&order] { order.push_back(1); }));
+  REQUIRE(subject.size() == 2);
+  REQUIRE(subject.run_local() == 2);
+  REQUIRE(order == std::vector<int>{ 0, 1 });
+  REQUIRE_FALSE(subject.run_one());
+}
+
+TEST_CASE("per cpu queues spill to the other queues when the local one is full", "[per_cpu_queue]")
+{
+  tmf::per_cpu_queue<2> subject{ 2 };
+  int ran = 0;
+  for (int task = 0; task < 4; ++task) {
+    REQUIRE(subject.try_post([&ran] { ++ran; }));
+  }
+  REQUIRE_FALSE(subject.try_post([&ran] { ++ran; }));
+  while (subject.run_one()) {
+  }
+  REQUIRE(ran == 4);
+  REQUIRE(subject.size() == 0);
+}
+
+TEST_CASE("per cpu queues report the cpu from the restartable sequence area", "[per_cpu_queue]")
+{
+  auto cpu = tmf::per_cpu_queue<>::current_cpu();
+  REQUIRE(cpu >= -1);
+  if (cpu >= 0) {
+    tmf::per_cpu_queue<> subject{ 1024 };
+    REQUIRE(subject.local() == static_cast<size_t>(cpu));
+  }
+}
+
+TEST_CASE("per cpu queues run every task posted from many threads once", "[per_cpu_queue]")
+{
+  constexpr int threads = 8;
+  constexpr int per_thread = 5000;
+  tmf::per_cpu_queue<64> subject{ 4 };
+  std::atomic<int> ran{ 0 };
+  std::vector<std::thread> workers;
+  for (int thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&] {
+      for (int post = 0; post < per_thread; ++post) {
+        while (!subject.try_post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); })) {
+          subject.run_one();
+        }
+        if (post % 8 == 0) {
+          subject.run_local();
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  while (subject.run_one()) {
+  }
+  REQUIRE(ran == threads * per_thread);
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <proactor.hpp>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+// a file that is unlinked as soon as it is opened
+struct temporary_file
+{
+  temporary_file()
+  {
+    char name[] = "/tmp/tmf_proactor_XXXXXX";
+    fd = ::mkstemp(name);
+    REQUIRE(fd != -1);
+    ::unlink(name);
+  }
+
+  ~temporary_file() { ::close(fd); }
+
+  int fd;
+};
+
+// drive `subject` until nothing is in flight
+void
+complete(tmf::proactor<>& subject)
+{
+  while (subject.in_flight() != 0) {
+    subject.run_once();
+  }
+}
+}
+
+TEST_CASE("proactors read files in batches", "[proactor]")
+{
+  for (bool emulate : { false, true }) {
+    tmf::proactor<> subject{ 8, emulate };
+    temporary_file file;
+    std::string contents = "0123456789abcdef";
+    REQUIRE(::pwrite(file.fd, contents.data(), contents.size(), 0) == static_cast<ssize_t>(contents.size()));
+    std::vector<char> buffers(contents.size());
+    std::vector<int> results(4, 0);
+    for (int block = 0; block < 4; ++block) {
+      subject.read(file.fd, &buffers[block * 4], 4, block * 4, [&results, block](int result) {
+        results[block] = result;
+      });
+    }
+    REQUIRE(subject.in_flight() == 4);
+    REQUIRE(subject.submit() == 4);
+    complete(subject);
+    REQUIRE(results == std::vector<int>{ 4, 4, 4, 4 });
+    REQUIRE(std::string(buffers.begin(), buffers.end()) == contents);
+  }
+}
+
+TEST_CASE("proactors write files and report errors", "[proactor]")
+{
+  for (bool emulate : { false, true }) {
+    tmf::proactor<> subject{ 4, emulate };
+    temporary_file file;
+    int written = 0;
+    int failed = 0;
+    subject.write(file.fd, "hello", 5, 0, [&written](int result) { written = result; });
+    subject.read(-1, nullptr, 1, 0, [&failed](int result) { failed = result; });
+    complete(subject);
+    REQUIRE(written == 5);
+    REQUIRE(failed == -EBADF);
+    char read_back[5] = {};
+    REQUIRE(::pread(file.fd, read_back, 5, 0) == 5);
+    REQUIRE(std::string(read_back, 5) == "hello");
+  }
+}
+
+TEST_CASE("proactor handlers can queue more operations", "[proactor]")
+{
+  for (bool emulate : { false, true }) {
+    tmf::proactor<> subject{ 2, emulate };
+    temporary_file file;
+    REQUIRE(::pwrite(file.fd, "abcdefgh", 8, 0) == 8);
+    struct reader
+    {
+      tmf::proactor<>* subject;
+      int fd;
+      std::string received;
+      char byte = 0;
+
+      void next(int result)
+      {
+        if (result == 1) {
+          received.push_back(byte);
+          subject->read(fd, &byte, 1, received.size(), this, &reader::next);
+        }
+      }
+    } sequential{ &subject, file.fd, {} };
+    subject.read(file.fd, &sequential.byte, 1, 0, &sequential, &reader::next);
+    complete(subject);
+    REQUIRE(sequential.received == "abcdefgh");
+  }
+}
+
+TEST_CASE("proactors throw when every slot is in use", "[proactor]")
+{
+  for (bool emulate : { false, true }) {
+    tmf::proactor<> subject{ 1, emulate };
+    temporary_file file;
+    char byte = 0;
+    size_t queued = 0;
+    REQUIRE_THROWS_AS(
+      [&] {
+        for (;; ++queued) {
+          subject.read(file.fd, &byte, 1, 0, [](int) {});
+        }
+      }(),
+      tmf::callable_exception);
+    REQUIRE(queued >= 2);
+    REQUIRE(subject.in_flight() == queued);
+    complete(subject);
+    REQUIRE(subject.in_flight() == 0);
+  }
+}
+
+TEST_CASE("proactor handlers that throw give their slot back", "[proactor]")
+{
+  for (bool emulate : { false, true }) {
+    tmf::proactor<> subject{ 4, emulate };
+    temporary_file file;
+    REQUIRE(::pwrite(file.fd, "abc", 3, 0) == 3);
+    char bytes[3] = {};
+    int ran = 0;
+    int thrown = 0;
+    subject.read(file.fd, &bytes[0], 1, 0, [](int) { throw std::runtime_error{ "handler failed" }; });
+    subject.read(file.fd, &bytes[1], 1, 1, [&ran](int) { ++ran; });
+    subject.read(file.fd, &bytes[2], 1, 2, [&ran](int) { ++ran; });
+    subject.submit();
+    // let every operation complete, so the handler that throws is likely not the last one ready
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+    while (ran + thrown < 3 && std::chrono::steady_clock::now() < deadline) {
+      try {
+        subject.run_once(false);
+      } catch (const std::runtime_error&) {
+        ++thrown;
+      }
+    }
+    REQUIRE(thrown == 1);
+    REQUIRE(ran == 2);
+    REQUIRE(subject.in_flight() == 0);
+  }
+}
+#endif
\ No newline at end of file
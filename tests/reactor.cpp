@@ -0,0 +1,213 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <reactor.hpp>
+
+#if defined(__linux__)
+#include <atomic>
+#include <cstdint>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+struct socket_pair
+{
+  socket_pair() { REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, ends) == 0); }
+
+  ~socket_pair()
+  {
+    for (auto end : ends) {
+      if (end != -1) {
+        ::close(end);
+      }
+    }
+  }
+
+  void send(char byte) { REQUIRE(::write(ends[1], &byte, 1) == 1); }
+
+  int ends[2] = { -1, -1 };
+};
+
+// read until the descriptor would block, as edge triggered handlers must
+std::vector<char>
+drain(int fd)
+{
+  std::vector<char> received;
+  char buffer[16];
+  for (ssize_t count; (count = ::read(fd, buffer, sizeof(buffer))) > 0;) {
+    received.insert(received.end(), buffer, buffer + count);
+  }
+  return received;
+}
+}
+
+TEST_CASE("reactors call the read handler of a readable descriptor", "[reactor]")
+{
+  tmf::reactor<> subject{ 1024 };
+  socket_pair sockets;
+  std::vector<char> received;
+  int reads = 0;
+  subject.add(sockets.ends[0], [&](int fd, std::uint32_t events) {
+    REQUIRE(fd == sockets.ends[0]);
+    REQUIRE((events & EPOLLIN) != 0);
+    auto bytes = drain(fd);
+    received.insert(received.end(), bytes.begin(), bytes.end());
+    ++reads;
+  });
+  REQUIRE(subject.watched() == 1);
+  REQUIRE(subject.run_once(0) == 0);
+  sockets.send('a');
+  sockets.send('b');
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(received == std::vector<char>{ 'a', 'b' });
+  REQUIRE(subject.run_once(0) == 0);
+  sockets.send('c');
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(reads == 2);
+}
+
+TEST_CASE("reactors call write and error handlers", "[reactor]")
+{
+  tmf::reactor<> subject{ 1024 };
+  socket_pair sockets;
+  int writes = 0;
+  int errors = 0;
+  subject.add(
+    sockets.ends[0],
+    {},
+    [&writes](int, std::uint32_t) { ++writes; },
+    [&errors](int, std::uint32_t events) {
+      REQUIRE((events & EPOLLHUP) != 0);
+      ++errors;
+    });
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(writes == 1);
+  ::close(sockets.ends[1]);
+  sockets.ends[1] = -1;
+  subject.run_once(1000);
+  REQUIRE(errors == 1);
+}
+
+TEST_CASE("reactor handlers can remove their own descriptor", "[reactor]")
+{
+  tmf::reactor<> subject{ 1024 };
+  socket_pair sockets;
+  int reads = 0;
+  subject.add(sockets.ends[0], [&](int fd, std::uint32_t) {
+    drain(fd);
+    ++reads;
+    subject.remove(fd);
+  });
+  sockets.send('a');
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(subject.watched() == 0);
+  sockets.send('b');
+  REQUIRE(subject.run_once(0) == 0);
+  REQUIRE(reads == 1);
+}
+
+TEST_CASE("reactor handlers outlive removing their own descriptor until they return", "[reactor]")
+{
+  tmf::reactor<> subject{ 1024 };
+  socket_pair sockets;
+  struct observed
+  {
+    tmf::reactor<>* subject;
+    bool in_call = false;
+    bool destroyed_in_call = false;
+    int calls = 0;
+  } seen{ &subject };
+  struct handler
+  {
+    handler(observed* watcher)
+      : observer(watcher)
+    {}
+
+    handler(const handler&) = default;
+
+    ~handler() { observer->destroyed_in_call |= observer->in_call; }
+
+    void operator()(int fd, std::uint32_t) const
+    {
+      observer->in_call = true;
+      drain(fd);
+      observer->subject->remove(fd);
+      ++observer->calls;
+      observer->in_call = false;
+    }
+
+    observed* observer;
+  };
+  subject.add(sockets.ends[0], handler{ &seen });
+  sockets.send('a');
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(seen.calls == 1);
+  REQUIRE_FALSE(seen.destroyed_in_call);
+  REQUIRE(subject.watched() == 0);
+}
+
+TEST_CASE("reactor handlers can replace their own handlers", "[reactor]")
+{
+  tmf::reactor<> subject{ 1024 };
+  socket_pair sockets;
+  std::vector<int> calls;
+  subject.add(sockets.ends[0], [&](int fd, std::uint32_t) {
+    drain(fd);
+    calls.push_back(1);
+    subject.add(fd, [&calls](int fd, std::uint32_t) {
+      drain(fd);
+      calls.push_back(2);
+    });
+  });
+  sockets.send('a');
+  REQUIRE(subject.run_once(1000) == 1);
+  sockets.send('b');
+  REQUIRE(subject.run_once(1000) == 1);
+  REQUIRE(calls == std::vector<int>{ 1, 2 });
+  REQUIRE(subject.watched() == 1);
+}
+
+TEST_CASE("reactors reject descriptors that do not fit", "[reactor]")
+{
+  tmf::reactor<> subject{ 4 };
+  socket_pair sockets;
+  REQUIRE_THROWS_AS(subject.add(-1, [](int, std::uint32_t) {}), tmf::callable_exception);
+  REQUIRE_THROWS_AS(subject.add(sockets.ends[0] + 4, [](int, std::uint32_t) {}), tmf::callable_exception);
+}
+
+TEST_CASE("reactors run tasks posted from other threads on their own", "[reactor]")
+{
+  constexpr int per_thread = 1000;
+  struct shared
+  {
+    tmf::reactor<> subject{ 1024 };
+    std::thread::id loop_thread = std::this_thread::get_id();
+    std::atomic<int> ran{ 0 };
+    bool other_thread = false;
+  } loop;
+  std::vector<std::thread> posters;
+  for (int thread = 0; thread < 4; ++thread) {
+    posters.emplace_back([&loop] {
+      for (int post = 0; post < per_thread; ++post) {
+        while (!loop.subject.post([&loop] {
+          loop.other_thread |= std::this_thread::get_id() != loop.loop_thread;
+          if (loop.ran.fetch_add(1) + 1 == 4 * per_thread) {
+            loop.subject.stop();
+          }
+        })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  loop.subject.run();
+  for (auto& poster : posters) {
+    poster.join();
+  }
+  REQUIRE(loop.ran == 4 * per_thread);
+  REQUIRE_FALSE(loop.other_thread);
+  REQUIRE(loop.subject.stopped());
+}
+#endif
\ No newline at end of file
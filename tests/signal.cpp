@@ -0,0 +1,95 @@
+#include "framework/catch.hpp"
+
+#include <signal.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("signals call every subscribed slot", "[signal]")
+{
+  tmf::signal<void(int)> subject;
+  int first_total = 0;
+  int second_total = 0;
+  auto first = subject.subscribe([&first_total](int value) { first_total += value; });
+  auto second = subject.subscribe([&second_total](int value) { second_total += value * 2; });
+  REQUIRE(subject.size() == 2);
+  subject.emit(1);
+  subject(2);
+  REQUIRE(first_total == 3);
+  REQUIRE(second_total == 6);
+  SECTION("until they are unsubscribed")
+  {
+    REQUIRE(subject.unsubscribe(first));
+    subject.emit(1);
+    REQUIRE(first_total == 3);
+    REQUIRE(second_total == 8);
+    REQUIRE(subject.size() == 1);
+  }
+  SECTION("and ended subscriptions stay ended when their slot is reused")
+  {
+    REQUIRE(subject.unsubscribe(first));
+    REQUIRE_FALSE(subject.unsubscribe(first));
+    int third_total = 0;
+    subject.subscribe([&third_total](int value) { third_total += value; });
+    REQUIRE_FALSE(subject.unsubscribe(first));
+    subject.emit(1);
+    REQUIRE(third_total == 1);
+    REQUIRE(second_total == 8);
+  }
+  SECTION("and slots may unsubscribe themselves while being emitted")
+  {
+    tmf::signal<void(int)>::connection self{};
+    int calls = 0;
+    self = subject.subscribe([&](int) {
+      ++calls;
+      subject.unsubscribe(self);
+    });
+    subject.emit(0);
+    subject.emit(0);
+    REQUIRE(calls == 1);
+  }
+  REQUIRE(subject.unsubscribe(second));
+}
+
+TEST_CASE("signals take every kind of source", "[signal]")
+{
+  tmf::signal<void(int&)> subject;
+  struct counter
+  {
+    void add(int& total) { total += 1; }
+    void operator()(int& total) { total += 10; }
+  } object;
+  auto shared = std::make_shared<counter>();
+  subject.subscribe(&object, &counter::add);
+  subject.subscribe(object);
+  subject.subscribe(shared);
+  subject.subscribe(shared, &counter::add);
+  int total = 0;
+  subject.emit(total);
+  REQUIRE(total == 22);
+}
+
+TEST_CASE("signals can be emitted while subscribers change", "[signal]")
+{
+  tmf::signal<void(int)> subject;
+  std::atomic<int> total{ 0 };
+  subject.subscribe([&total](int value) { total.fetch_add(value); });
+  std::atomic<bool> done{ false };
+  std::thread churn{ [&] {
+    for (int round = 0; round < 2000; ++round) {
+      auto subscription = subject.subscribe([&total](int) { total.fetch_add(0); });
+      subject.unsubscribe(subscription);
+    }
+    done = true;
+  } };
+  int emitted = 0;
+  while (!done) {
+    subject.emit(1);
+    ++emitted;
+  }
+  churn.join();
+  REQUIRE(total == emitted);
+  REQUIRE(subject.size() == 1);
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <spsc_ring.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+int free_function_calls = 0;
+
+void
+count_call()
+{
+  ++free_function_calls;
+}
+}
+
+TEST_CASE("spsc rings run tasks of different sizes in order", "[spsc_ring]")
+{
+  tmf::spsc_ring<256> subject;
+  std::vector<int> order;
+  std::array<std::uint64_t, 8> padding{};
+  REQUIRE(subject.empty());
+  REQUIRE(subject.try_push([&order] { order.push_back(0); }));
+  REQUIRE(subject.try_push([&order, padding] { order.push_back(1 + static_cast<int>(padding[0])); }));
+  REQUIRE(subject.try_push([&order] { order.push_back(2); }));
+  REQUIRE(subject.drain() == 3);
+  REQUIRE(order == std::vector<int>{ 0, 1, 2 });
+  REQUIRE(subject.empty());
+  REQUIRE_FALSE(subject.try_pop());
+}
+
+TEST_CASE("spsc ring entries are packed to the size of their source", "[spsc_ring]")
+{
+  auto small = [value = std::uint64_t{ 0 }] { (void)value; };
+  REQUIRE(tmf::spsc_ring<256>::entry_size<decltype(small)>() == 24);
+  REQUIRE(tmf::spsc_ring<256>::entry_size<void (*)()>() == 24);
+}
+
+TEST_CASE("spsc rings refuse tasks when full and wrap around when drained", "[spsc_ring]")
+{
+  tmf::spsc_ring<64> subject;
+  int calls = 0;
+  auto task = [&calls, padding = std::array<std::uint64_t, 1>{}] { calls += 1 + static_cast<int>(padding[0]); };
+  // 24 byte entries, the last 16 bytes of the buffer are skipped
+  for (int round = 0; round < 10; ++round) {
+    REQUIRE(subject.try_push(task));
+    REQUIRE(subject.try_push(task));
+    REQUIRE_FALSE(subject.try_push(task));
+    REQUIRE(subject.try_pop());
+    REQUIRE(subject.try_pop());
+  }
+  REQUIRE(calls == 20);
+}
+
+TEST_CASE("spsc rings take every kind of source", "[spsc_ring]")
+{
+  struct counter
+  {
+    void add() { total += 1; }
+    void operator()() { total += 10; }
+    int total = 0;
+  };
+  tmf::spsc_ring<512> subject;
+  counter object;
+  auto shared = std::make_shared<counter>();
+  free_function_calls = 0;
+  REQUIRE(subject.try_push(&count_call));
+  REQUIRE(subject.try_push(&object));
+  REQUIRE(subject.try_push(shared));
+  REQUIRE(subject.try_push(&object, &counter::add));
+  REQUIRE(subject.try_push(shared, &counter::add));
+  REQUIRE(subject.drain() == 5);
+  REQUIRE(free_function_calls == 1);
+  REQUIRE(object.total == 11);
+  REQUIRE(shared->total == 11);
+}
+
+TEST_CASE("spsc rings destroy tasks that were run or never run", "[spsc_ring]")
+{
+  int check_value = 0;
+  {
+    tmf::spsc_ring<256> subject;
+    auto state = std::make_shared<non_trivial_destructing>(&check_value);
+    REQUIRE(subject.try_push([state] {}));
+    REQUIRE(subject.try_push([state] {}));
+    state.reset();
+    REQUIRE(subject.try_pop());
+    REQUIRE(check_value == 0);
+  }
+  REQUIRE(check_value == 1);
+}
+
+TEST_CASE("spsc rings skip a task that threw instead of running it again", "[spsc_ring]")
+{
+  struct counted
+  {
+    counted(int& ran_count, int& destroyed_count, bool throws)
+      : ran(&ran_count)
+      , destroyed(&destroyed_count)
+      , throwing(throws)
+    {}
+
+    counted(counted&& other) noexcept
+      : ran(std::exchange(other.ran, nullptr))
+      , destroyed(std::exchange(other.destroyed, nullptr))
+      , throwing(other.throwing)
+    {}
+
+    ~counted()
+    {
+      if (destroyed != nullptr) {
+        ++*destroyed;
+      }
+    }
+
+    void operator()()
+    {
+      ++*ran;
+      if (throwing) {
+        throw std::runtime_error{ "task failed" };
+      }
+    }
+
+    int* ran;
+    int* destroyed;
+    bool throwing;
+  };
+
+  tmf::spsc_ring<256> subject;
+  int ran = 0;
+  int destroyed = 0;
+  int after = 0;
+  REQUIRE(subject.try_push(counted{ ran, destroyed, true }));
+  REQUIRE(subject.try_push([&after] { ++after; }));
+  REQUIRE_THROWS_AS(subject.drain(), std::runtime_error);
+  REQUIRE(ran == 1);
+  REQUIRE(destroyed == 1);
+  REQUIRE(subject.drain() == 1);
+  REQUIRE(ran == 1);
+  REQUIRE(destroyed == 1);
+  REQUIRE(after == 1);
+  REQUIRE(subject.empty());
+}
+
+TEST_CASE("spsc rings pass tasks between two threads", "[spsc_ring]")
+{
+  constexpr std::uint64_t tasks = 20000;
+  tmf::spsc_ring<1024> subject;
+  std::uint64_t total = 0;
+  std::thread producer{ [&] {
+    for (std::uint64_t index = 1; index <= tasks; ++index) {
+      // alternate sizes so entries wrap at different offsets
+      if (index % 3 == 0) {
+        while (!subject.try_push([&total, index, padding = std::array<std::uint64_t, 5>{}] { total += index + padding[4]; })) {
+          std::this_thread::yield();
+        }
+      } else {
+        while (!subject.try_push([&total, index] { total += index; })) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  } };
+  std::uint64_t ran = 0;
+  while (ran < tasks) {
+    ran += subject.drain();
+  }
+  producer.join();
+  REQUIRE(total == tasks * (tasks + 1) / 2);
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <task.hpp>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+tmf::task<int>
+constant(int value)
+{
+  co_return value;
+}
+
+tmf::task<int>
+sum_of_constants(int count)
+{
+  int total = 0;
+  for (int index = 1; index <= count; ++index) {
+    total += co_await constant(index);
+  }
+  co_return total;
+}
+
+tmf::task<std::string>
+failing()
+{
+  throw std::logic_error{ "failed" };
+  co_return std::string{};
+}
+
+tmf::task<bool>
+catches_failure()
+{
+  try {
+    co_await failing();
+  } catch (const std::logic_error&) {
+    co_return true;
+  }
+  co_return false;
+}
+
+// resumes the awaiting coroutine on a worker of `pool`
+template<typename PoolT>
+struct resume_on
+{
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) { pool.post([handle] { handle.resume(); }); }
+
+  void await_resume() const noexcept {}
+
+  PoolT& pool;
+};
+
+template<typename PoolT>
+tmf::task<std::thread::id>
+worker_thread(PoolT& pool)
+{
+  co_await resume_on<PoolT>{ pool };
+  co_return std::this_thread::get_id();
+}
+
+template<typename PoolT>
+tmf::task<int>
+hops(PoolT& pool, int count)
+{
+  auto caller = std::this_thread::get_id();
+  int away = 0;
+  for (int index = 0; index < count; ++index) {
+    if (co_await worker_thread(pool) != caller) {
+      ++away;
+    }
+  }
+  co_return away;
+}
+
+}
+
+TEST_CASE("tasks start lazily and run a callback when done", "[task]")
+{
+  auto subject = constant(7);
+  REQUIRE(subject.valid());
+  REQUIRE_FALSE(subject.done());
+  REQUIRE_THROWS_AS(subject.result(), tmf::callable_exception);
+  int callbacks = 0;
+  subject.start([&callbacks] { ++callbacks; });
+  REQUIRE(subject.done());
+  REQUIRE(callbacks == 1);
+  REQUIRE(subject.result() == 7);
+}
+
+TEST_CASE("tasks await other tasks", "[task]")
+{
+  auto subject = sum_of_constants(10);
+  subject.start();
+  REQUIRE(subject.result() == 55);
+  SECTION("without growing the stack when they finish synchronously")
+  {
+    auto deep = sum_of_constants(200000);
+    deep.start();
+    REQUIRE(deep.done());
+  }
+}
+
+TEST_CASE("awaiting a finished task carries on synchronously", "[task]")
+{
+  auto inner = constant(3);
+  inner.start();
+  REQUIRE(inner.done());
+  auto outer = [](tmf::task<int>& awaited) -> tmf::task<int> { co_return co_await awaited + 1; }(inner);
+  outer.start();
+  REQUIRE(outer.done());
+  REQUIRE(outer.result() == 4);
+}
+
+TEST_CASE("tasks pass exceptions to whoever awaits them", "[task]")
+{
+  auto subject = catches_failure();
+  subject.start();
+  REQUIRE(subject.result());
+  auto thrown = failing();
+  thrown.start();
+  REQUIRE(thrown.done());
+  REQUIRE_THROWS_AS(thrown.result(), std::logic_error);
+}
+
+TEST_CASE("tasks resume on the thread that finished what they awaited", "[task]")
+{
+  tmf::thread_pool<64> pool{ 2 };
+  std::atomic<bool> finished{ false };
+  auto subject = hops(pool, 100);
+  subject.start([&finished] { finished.store(true); });
+  while (!finished.load()) {
+    std::this_thread::yield();
+  }
+  REQUIRE(subject.done());
+  REQUIRE(subject.result() == 100);
+}
+
+TEST_CASE("frame pools recycle frames by size class", "[task]")
+{
+  auto first = tmf::frame_pool::allocate(100);
+  auto cached = tmf::frame_pool::cached(100);
+  tmf::frame_pool::deallocate(first, 100);
+  REQUIRE(tmf::frame_pool::cached(100) == cached + 1);
+  REQUIRE(tmf::frame_pool::allocate(128) == first);
+  tmf::frame_pool::deallocate(first, 128);
+  auto large = tmf::frame_pool::allocate(tmf::frame_pool::largest_frame + 1);
+  REQUIRE(tmf::frame_pool::cached(tmf::frame_pool::largest_frame + 1) == 0);
+  tmf::frame_pool::deallocate(large, tmf::frame_pool::largest_frame + 1);
+}
\ No newline at end of file
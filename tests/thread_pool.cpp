@@ -0,0 +1,142 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+std::atomic<int> free_function_calls{ 0 };
+
+void
+count_call()
+{
+  free_function_calls.fetch_add(1);
+}
+
+// joins two recursive calls by running queued tasks until the posted half is done
+template<typename PoolT>
+long
+fibonacci(PoolT& pool, int number)
+{
+  if (number < 2) {
+    return number;
+  }
+  struct half
+  {
+    long result;
+    std::atomic<bool> done;
+  } posted{ 0, { false } };
+  pool.post([&pool, &posted, number] {
+    posted.result = fibonacci(pool, number - 1);
+    posted.done.store(true, std::memory_order_release);
+  });
+  auto inline_result = fibonacci(pool, number - 2);
+  while (!posted.done.load(std::memory_order_acquire)) {
+    if (!pool.run_one()) {
+      std::this_thread::yield();
+    }
+  }
+  return posted.result + inline_result;
+}
+}
+
+TEST_CASE("thread pools run every posted task before they are destroyed", "[thread_pool]")
+{
+  constexpr int tasks = 10000;
+  std::atomic<long> total{ 0 };
+  {
+    tmf::thread_pool<64> subject{ 3 };
+    REQUIRE(subject.threads() == 3);
+    for (int index = 1; index <= tasks; ++index) {
+      subject.post([&total, index] { total.fetch_add(index); });
+    }
+  }
+  REQUIRE(total == long{ tasks } * (tasks + 1) / 2);
+}
+
+TEST_CASE("thread pools take every kind of source", "[thread_pool]")
+{
+  struct counter
+  {
+    void add() { total.fetch_add(1); }
+    void operator()() { total.fetch_add(10); }
+    std::atomic<int> total{ 0 };
+  };
+  counter object;
+  auto shared = std::make_shared<counter>();
+  free_function_calls = 0;
+  {
+    tmf::thread_pool<> subject{ 2 };
+    subject.post(&count_call);
+    subject.post(&object);
+    subject.post(shared);
+    subject.post(&object, &counter::add);
+    subject.post(shared, &counter::add);
+  }
+  REQUIRE(free_function_calls == 1);
+  REQUIRE(object.total == 11);
+  REQUIRE(shared->total == 11);
+  REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("thread pools release task state once the task has run", "[thread_pool]")
+{
+  int check_value = 0;
+  {
+    tmf::thread_pool<> subject{ 1 };
+    auto state = std::make_shared<non_trivial_destructing>(&check_value);
+    std::atomic<bool> ran{ false };
+    subject.post([state, &ran] { ran.store(true); });
+    state.reset();
+    while (!ran.load()) {
+      std::this_thread::yield();
+    }
+  }
+  REQUIRE(check_value == 1);
+}
+
+TEST_CASE("thread pools run tasks on the caller when every queue is full", "[thread_pool]")
+{
+  std::atomic<bool> release{ false };
+  std::atomic<int> ran{ 0 };
+  int ran_by_caller = 0;
+  auto caller = std::this_thread::get_id();
+  {
+    tmf::thread_pool<2> subject{ 1 };
+    subject.post([&release] {
+      while (!release.load()) {
+        std::this_thread::yield();
+      }
+    });
+    for (int index = 0; index < 8; ++index) {
+      subject.post([&ran, &ran_by_caller, caller] {
+        if (std::this_thread::get_id() == caller) {
+          ++ran_by_caller;
+        }
+        ran.fetch_add(1);
+      });
+    }
+    release.store(true);
+  }
+  REQUIRE(ran == 8);
+  REQUIRE(ran_by_caller >= 5);
+}
+
+TEST_CASE("thread pools join forked work by helping", "[thread_pool]")
+{
+  tmf::thread_pool<256> subject{ 4 };
+  long result = 0;
+  std::atomic<bool> done{ false };
+  subject.post([&] {
+    result = fibonacci(subject, 20);
+    done.store(true);
+  });
+  while (!done.load()) {
+    std::this_thread::yield();
+  }
+  REQUIRE(result == 6765);
+  REQUIRE(fibonacci(subject, 15) == 610);
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "framework/types.hpp"
+#include "framework/catch.hpp"
+
+#include <timer_wheel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#endif
+
+using namespace std::chrono_literals;
+
+TEST_CASE("timer wheels run timers once their deadline has passed", "[timer_wheel]")
+{
+  auto start = tmf::timer_wheel<>::clock::time_point{};
+  tmf::timer_wheel<> subject{ 16, 1ms, start };
+  std::vector<int> fired;
+  subject.schedule_at(start + 3ms, [&fired] { fired.push_back(3); });
+  subject.schedule_at(start + 1500us, [&fired] { fired.push_back(2); });
+  subject.schedule_after(1ms, [&fired] { fired.push_back(1); });
+  REQUIRE(subject.pending() == 3);
+  REQUIRE(subject.advance(start) == 0);
+  REQUIRE(subject.advance(start + 1ms) == 1);
+  REQUIRE(subject.advance(start + 1999us) == 0);
+  REQUIRE(subject.advance(start + 10ms) == 2);
+  REQUIRE(fired == std::vector<int>{ 1, 2, 3 });
+  REQUIRE(subject.pending() == 0);
+}
+
+TEST_CASE("timer wheels cancel timers through their handles", "[timer_wheel]")
+{
+  auto start = tmf::timer_wheel<>::clock::time_point{};
+  tmf::timer_wheel<> subject{ 4, 1ms, start };
+  int fired = 0;
+  auto cancelled = subject.schedule_after(5ms, [&fired] { fired += 1; });
+  auto kept = subject.schedule_after(5ms, [&fired] { fired += 10; });
+  REQUIRE(subject.cancel(cancelled));
+  REQUIRE_FALSE(subject.cancel(cancelled));
+  REQUIRE(subject.pending() == 1);
+  // the node is reused, the stale handle must not cancel its new timer
+  auto reused = subject.schedule_after(5ms, [&fired] { fired += 100; });
+  REQUIRE(reused.index == cancelled.index);
+  REQUIRE_FALSE(subject.cancel(cancelled));
+  subject.advance(start + 5ms);
+  REQUIRE(fired == 110);
+  REQUIRE_FALSE(subject.cancel(kept));
+}
+
+TEST_CASE("timer wheels cascade long timers down the levels", "[timer_wheel]")
+{
+  auto start = tmf::timer_wheel<>::clock::time_point{};
+  tmf::timer_wheel<> subject{ 8, 1ms, start };
+  std::vector<std::uint64_t> fired;
+  std::uint64_t current = 0;
+  for (std::uint64_t ticks : { 255u, 256u, 70000u, 16777300u }) {
+    subject.schedule_at(start + std::chrono::milliseconds{ ticks }, [&fired, &current] { fired.push_back(current); });
+  }
+  // step up to each deadline in a few jumps, and check nothing fires early
+  for (std::uint64_t ticks : { 254u, 255u, 256u, 69999u, 70000u, 16777299u, 16777300u }) {
+    current = ticks;
+    subject.advance(start + std::chrono::milliseconds{ ticks });
+  }
+  REQUIRE(fired == std::vector<std::uint64_t>{ 255, 256, 70000, 16777300 });
+}
+
+TEST_CASE("timer wheels park timers beyond their reach", "[timer_wheel]")
+{
+  auto start = tmf::timer_wheel<>::clock::time_point{};
+  tmf::timer_wheel<> subject{ 2, 1ns, start };
+  bool fired = false;
+  auto deadline = (std::uint64_t{ 1 } << 32) + 1000;
+  subject.schedule_at(start + std::chrono::nanoseconds{ deadline }, [&fired] { fired = true; });
+  subject.schedule_at(start + 1ns, [] {});
+  subject.advance(start + std::chrono::nanoseconds{ deadline - 1 });
+  REQUIRE_FALSE(fired);
+  subject.advance(start + std::chrono::nanoseconds{ deadline });
+  REQUIRE(fired);
+}
+
+TEST_CASE("timer wheel callbacks can schedule and cancel timers", "[timer_wheel]")
+{
+  auto start = tmf::timer_wheel<>::clock::time_point{};
+  tmf::timer_wheel<> subject{ 4, 1ms, start };
+  int repeats = 0;
+  int rivals = 0;
+  tmf::timer_wheel<>::timer first;
+  tmf::timer_wheel<>::timer second;
+  struct repeat
+  {
+    void operator()()
+    {
+      if (++*count < 5) {
+        wheel->schedule_after(0ms, *this);
+      }
+    }
+    tmf::timer_wheel<>* wheel;
+    int* count;
+  };
+  subject.schedule_after(1ms, repeat{ &subject, &repeats });
+  // timers of the same tick run in no particular order, whichever of these runs first cancels the other
+  first = subject.schedule_after(1ms, [&] {
+    ++rivals;
+    subject.cancel(second);
+  });
+  second = subject.schedule_after(1ms, [&] {
+    ++rivals;
+    subject.cancel(first);
+  });
+  subject.advance(start + 1ms);
+  REQUIRE(repeats == 1);
+  REQUIRE(rivals == 1);
+  subject.advance(start + 10ms);
+  REQUIRE(repeats == 5);
+  REQUIRE(subject.pending() == 0);
+}
+
+TEST_CASE("timer wheels refuse timers beyond their pool and release callback state", "[timer_wheel]")
+{
+  int check_value = 0;
+  {
+    tmf::timer_wheel<> subject{ 1, 1ms };
+    auto state = std::make_shared<non_trivial_destructing>(&check_value);
+    auto scheduled = subject.schedule_after(1s, [state] {});
+    REQUIRE_THROWS_AS(subject.schedule_after(1s, [] {}), tmf::callable_exception);
+    state.reset();
+    REQUIRE(check_value == 0);
+    subject.cancel(scheduled);
+    REQUIRE(check_value == 1);
+  }
+}
+
+#if defined(__linux__)
+TEST_CASE("timer wheels tick from a timerfd", "[timer_wheel]")
+{
+  tmf::timer_wheel<> subject{ 4, 1ms };
+  bool fired = false;
+  subject.schedule_after(3ms, [&fired] { fired = true; });
+  pollfd readable{ subject.tick_fd(), POLLIN, 0 };
+  for (int wakeups = 0; !fired && wakeups < 1000; ++wakeups) {
+    REQUIRE(::poll(&readable, 1, 100) == 1);
+    subject.on_tick();
+  }
+  REQUIRE(fired);
+}
+#endif
\ No newline at end of file